@@ -0,0 +1,135 @@
+#include "unoptimized/sudoku_unoptimize.hpp"
+#include "common/board_parse.hpp"
+#include "common/board_writer.hpp"
+#include "common/cpu_dispatch.hpp"
+#include "common/board_packed.hpp"
+#include "common/latency_histogram.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Batch: um tabuleiro por linha à entrada, uma solução por linha à saída.
+// Tabuleiros sem solução são escritos tal como vieram (com os zeros).
+// A entrada também pode estar no formato compacto (detetado pelo cabeçalho);
+// com --packed a saída é escrita nesse formato.
+// O tempo de cada solve vai para um histograma por classe de dificuldade
+// (common/latency_histogram.hpp), que pode ser guardado com --hist/--hist-csv.
+// Uso: ./batch_<solver>.exe [--packed] [--hist F] [--hist-csv F]
+//                           <ficheiro> [ficheiro_de_saída]
+
+using Clock = std::chrono::steady_clock;
+
+static long get_micros(const std::chrono::steady_clock::time_point& start,
+                       const std::chrono::steady_clock::time_point& end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+}
+
+int main(int argc, char* argv[]) {
+    BoardFormat format = BoardFormat::LINES;
+    const char* hist_path = nullptr;
+    const char* hist_csv_path = nullptr;
+    int arg = 1;
+
+    for (; arg < argc && std::strncmp(argv[arg], "--", 2) == 0; arg++) {
+        if (std::strcmp(argv[arg], "--packed") == 0)
+            format = BoardFormat::PACKED;
+        else if (std::strcmp(argv[arg], "--hist") == 0 && arg + 1 < argc)
+            hist_path = argv[++arg];
+        else if (std::strcmp(argv[arg], "--hist-csv") == 0 && arg + 1 < argc)
+            hist_csv_path = argv[++arg];
+        else
+            break;
+    }
+
+    if (arg >= argc || std::strncmp(argv[arg], "--", 2) == 0) {
+        std::fprintf(stderr,
+                     "Usage: %s [--packed] [--hist file] [--hist-csv file] <boards_file> [output_file]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    const char* in_path = argv[arg];
+    const char* out_path = arg + 1 < argc ? argv[arg + 1] : nullptr;
+
+    int out_fd = STDOUT_FILENO;
+    if (out_path) {
+        out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out_fd < 0) {
+            std::fprintf(stderr, "Error opening output: %s\n", out_path);
+            return 1;
+        }
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::vector<Board> boards;
+    if (load_boards(in_path, boards) != 0) {
+        std::fprintf(stderr, "Error reading file: %s\n", in_path);
+        return 1;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::vector<Board> solutions(boards.size());
+    std::size_t solved = 0;
+
+    LatencyReport latency;
+    LatencyReport::Entry& hist = latency.engine(engine_name_from_program(argv[0]));
+
+    for (std::size_t i = 0; i < boards.size(); i++) {
+        auto start = Clock::now();
+        int found = solve(boards[i], solutions[i]);
+        auto end = Clock::now();
+        latency.record(hist, boards[i],
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+        if (found == 1)
+            solved++;
+        else
+            solutions[i] = boards[i];
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+
+    int write_err;
+    {
+        BoardWriter writer(out_fd, format);
+        for (const Board& b : solutions)
+            writer.write_board(b);
+        write_err = writer.flush();
+    }
+
+    auto t3 = std::chrono::steady_clock::now();
+
+    if (out_fd != STDOUT_FILENO)
+        close(out_fd);
+
+    std::fprintf(stderr,
+                 "Boards: %zu, solved: %zu (dispatch %s)\n"
+                 "Load  : %ld us\n"
+                 "Solve : %ld us\n"
+                 "Write : %ld us\n",
+                 boards.size(), solved, cpu_dispatch_level(),
+                 get_micros(t0, t1), get_micros(t1, t2), get_micros(t2, t3));
+
+    std::fprintf(stderr, "\n");
+    latency.print(stderr);
+
+    if (hist_path && latency.save(hist_path) != 0) {
+        std::fprintf(stderr, "Error writing histogram: %s\n", hist_path);
+        return 1;
+    }
+    if (hist_csv_path && latency.write_csv(hist_csv_path) != 0) {
+        std::fprintf(stderr, "Error writing histogram: %s\n", hist_csv_path);
+        return 1;
+    }
+
+    return write_err;
+}
@@ -1,11 +1,93 @@
-#include <iostream>
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 
-#include "unoptimized/sudoku_unoptimize.hpp"
-#include "bitmaskingrmv/sudoku_bitmasking_rmv.hpp"
-#include "bitmaskingrmvfc/sudoku_bitmasking_rmv_fc.hpp"
-#include "dlx/sudoku_dlx.hpp"
+#include "common/bench.hpp"
+#include "common/board_dir.hpp"
+#include "common/board_parse.hpp"
+#include "common/engines.hpp"
+#include "common/cpu_dispatch.hpp"
+#include "common/latency_histogram.hpp"
+#include "common/mem_probe.hpp"
+#include "common/perf_counters.hpp"
+
+// --------------------------------------------------
+// Benchmark estatístico: todos os solvers x todos os tabuleiros, num só
+// processo (sem o custo de arranque que o benchmark.py mede).
+//
+// Para cada par solver x tabuleiro:
+//   1. calibração: iterações por amostra até cada amostra durar pelo menos
+//      --min-sample-ms (a resolução do relógio deixa de contar);
+//   2. --samples amostras (ou menos, se o par passar de --max-time-ms);
+//   3. estatísticas do tempo por iteração, em ns;
+//   4. contadores de hardware (perf_counters.hpp) à volta de cada chamada
+//      a solve, numa passagem à parte para não afetar os tempos;
+//   5. --hist-calls chamadas com o tempo de cada uma num histograma
+//      (latency_histogram.hpp), por solver e classe de dificuldade; o mesmo
+//      número por tabuleiro, para os rápidos não pesarem mais nos percentis;
+//   6. uma chamada com as alocações no heap contadas e a pilha pintada
+//      (mem_probe.hpp): alocações, bytes e pilha máxima por solve.
+//
+// Uso: ./benchmark.exe [--engine NOME]... [--board FICHEIRO]...
+//                      [--boards-dir DIR] [--samples N] [--min-sample-ms X]
+//                      [--max-time-ms X] [--json FICHEIRO|-] [--csv FICHEIRO|-]
+//                      [--no-perf] [--no-mem] [--hist FICHEIRO] [--hist-csv FICHEIRO]
+//                      [--hist-calls N]
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int MIN_SAMPLES = 5;
+
+struct Options {
+    std::vector<const Engine*> engines;
+    std::vector<std::string> boards;
+    const char* boards_dir = "../boards";
+    int samples = 25;
+    double min_sample_ms = 2.0;
+    double max_time_ms = 3000.0; // por par solver x tabuleiro
+    const char* json_path = nullptr;
+    const char* csv_path = nullptr;
+    bool perf = true;
+    bool mem = true;
+    const char* hist_path = nullptr;
+    const char* hist_csv_path = nullptr;
+    int hist_calls = 100; // chamadas no histograma por par solver x tabuleiro
+};
+
+// INVALID_INPUT: o tabuleiro já tem pistas em conflito. Os solvers não
+// verificam isto (a versão em C faz is_board_valid antes), por isso o
+// resultado não conta como erro, mas o tempo é medido na mesma.
+enum class Outcome { SOLVED, NO_SOLUTION, INVALID_INPUT, WRONG_SOLUTION, UNREADABLE };
+
+static const char* outcome_name(Outcome o) {
+    switch (o) {
+        case Outcome::SOLVED:         return "solved";
+        case Outcome::NO_SOLUTION:    return "no_solution";
+        case Outcome::INVALID_INPUT:  return "invalid_input";
+        case Outcome::WRONG_SOLUTION: return "WRONG";
+        case Outcome::UNREADABLE:     return "unreadable";
+    }
+    return "unknown";
+}
+
+struct Result {
+    const Engine* engine = nullptr;
+    std::string board;
+    Outcome outcome = Outcome::UNREADABLE;
+    std::uint64_t iterations = 0; // por amostra
+    SampleStats stats;
+    double counters[PERF_COUNTER_COUNT] = {}; // média por chamada
+    bool counted[PERF_COUNTER_COUNT] = {};
+    bool mem_probed = false; // por solve:
+    std::uint64_t allocs = 0;
+    std::uint64_t alloc_bytes = 0;
+    std::size_t stack_bytes = 0;
+};
 
 // --------------------------------------------------
 // Validação de solução Sudoku
@@ -38,139 +120,511 @@ static bool validate_solution(const Board& original, const Board& solved) {
     return true;
 }
 
-// --------------------------------------------------
-// Enum de solvers
+// Pistas sem repetições em linhas, colunas e caixas
+static bool clues_consistent(const Board& board) {
+    bool row[9][10] = {};
+    bool col[9][10] = {};
+    bool box[9][10] = {};
 
-enum class SolverType {
-    UNOPTIMIZED,
-    BITMASKING,
-    BITMASKING_FC,
-    DLX
-};
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int v = board.cells[r * 9 + c];
+            if (v == 0)
+                continue;
 
-const char* solver_name(SolverType t) {
-    switch (t) {
-        case SolverType::UNOPTIMIZED:    return "Unoptimized";
-        case SolverType::BITMASKING:    return "Bitmasking+MRV";
-        case SolverType::BITMASKING_FC: return "Bitmasking+MRV+FC";
-        case SolverType::DLX:           return "DLX (Algorithm X)";
+            int b = (r / 3) * 3 + (c / 3);
+            if (row[r][v] || col[c][v] || box[b][v])
+                return false;
+            row[r][v] = col[c][v] = box[b][v] = true;
+        }
     }
-    return "Unknown";
+    return true;
 }
 
 // --------------------------------------------------
-// Wrappers (evitam confusão de linking)
+// Medição
+
+// Tempo (ns) de "iters" chamadas seguidas
+static double time_batch(const Engine& engine, const Board& input, std::uint64_t iters) {
+    Board solution;
+    auto start = Clock::now();
+
+    for (std::uint64_t i = 0; i < iters; i++) {
+        Board in = input;
+        do_not_optimize(in);
+        int found = engine.solve(in, solution);
+        do_not_optimize(found);
+        do_not_optimize(solution);
+    }
 
-static bool solve_unoptimized(const Board& in, Board& out) {
-    return solve(in, out) == 1;
+    auto end = Clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
 }
 
-static bool solve_bitmasking(const Board& in, Board& out) {
-    return solve(in, out) == 1;
+static std::uint64_t calibrate(const Engine& engine, const Board& input, double min_sample_ns) {
+    std::uint64_t iters = 1;
+
+    for (;;) {
+        double ns = time_batch(engine, input, iters);
+        if (ns >= min_sample_ns || iters >= (std::uint64_t(1) << 30))
+            return iters;
+
+        // Estimativa com 20% de margem, entre x2 e x100 por passo
+        double scale = ns > 0 ? min_sample_ns / ns * 1.2 : 100.0;
+        if (scale < 2)
+            scale = 2;
+        if (scale > 100)
+            scale = 100;
+        iters = static_cast<std::uint64_t>(double(iters) * scale);
+    }
 }
 
-static bool solve_bitmasking_fc(const Board& in, Board& out) {
-    return solve(in, out) == 1;
+// Soma dos contadores de "iters" chamadas, cada uma entre start/stop
+static void count_calls(const Engine& engine, const Board& input, std::uint64_t iters,
+                        PerfCounters& perf, Result& res) {
+    std::uint64_t totals[PERF_COUNTER_COUNT] = {};
+    std::uint64_t counted_calls = 0;
+    Board solution;
+    PerfSample sample;
+
+    for (std::uint64_t i = 0; i < iters; i++) {
+        Board in = input;
+        do_not_optimize(in);
+        perf.start();
+        int found = engine.solve(in, solution);
+        do_not_optimize(found);
+        do_not_optimize(solution);
+        if (perf.stop(sample) != 0)
+            continue;
+
+        counted_calls++;
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            totals[c] += sample.values[c];
+            res.counted[c] = res.counted[c] || sample.present[c];
+        }
+    }
+
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (counted_calls == 0)
+            res.counted[c] = false;
+        else
+            res.counters[c] = double(totals[c]) / double(counted_calls);
+    }
 }
 
-static bool solve_dlx(const Board& in, Board& out) {
-    return solve(in, out) == 1;
+// Tempo de cada uma de "iters" chamadas, para o histograma
+static void record_calls(const Engine& engine, const Board& input, std::uint64_t iters,
+                         LatencyReport& latency) {
+    LatencyReport::Entry& hist = latency.engine(engine.name);
+    Board solution;
+
+    for (std::uint64_t i = 0; i < iters; i++) {
+        Board in = input;
+        do_not_optimize(in);
+        auto start = Clock::now();
+        int found = engine.solve(in, solution);
+        do_not_optimize(found);
+        do_not_optimize(solution);
+        auto end = Clock::now();
+        latency.record(hist, input, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    }
 }
 
-// --------------------------------------------------
+// Uma chamada a solve, na pilha da StackProbe
+struct MemProbeCall {
+    const Engine* engine;
+    Board input;
+    Board solution;
+};
 
-int main(int argc, char* argv[]) {
-    if (argc < 3) {
-        std::cout << "Usage:\n";
-        std::cout << "  ./benchmark.exe <unoptimized|bitmasking|bitmasking_fc|dlx> <board_file>\n";
-        return 1;
+static void probe_solve(void* arg) {
+    MemProbeCall* call = static_cast<MemProbeCall*>(arg);
+    int found = call->engine->solve(call->input, call->solution);
+    do_not_optimize(found);
+}
+
+// Alocações e pilha de uma chamada (o solve é determinista, uma basta)
+static void probe_memory(const Engine& engine, const Board& input, StackProbe& stack,
+                         Result& res) {
+    MemProbeCall call{&engine, input, Board{}};
+    AllocCounting counting;
+
+    AllocCount before = alloc_count();
+    res.stack_bytes = stack.run(probe_solve, &call);
+    AllocCount after = alloc_count();
+
+    res.allocs = after.allocs - before.allocs;
+    res.alloc_bytes = after.bytes - before.bytes;
+    res.mem_probed = true;
+}
+
+static Result run_pair(const Engine& engine, const std::string& path, const Options& opt,
+                       PerfCounters* perf, StackProbe* stack, LatencyReport& latency) {
+    Result res;
+    res.engine = &engine;
+    res.board = path.substr(path.find_last_of('/') + 1);
+
+    Board input;
+    if (read_file_raw(input, path.c_str()) != 0)
+        return res;
+
+    Board solution;
+    if (!clues_consistent(input))
+        res.outcome = Outcome::INVALID_INPUT;
+    else if (engine.solve(input, solution) != 1)
+        res.outcome = Outcome::NO_SOLUTION;
+    else if (validate_solution(input, solution))
+        res.outcome = Outcome::SOLVED;
+    else
+        res.outcome = Outcome::WRONG_SOLUTION;
+
+    res.iterations = calibrate(engine, input, opt.min_sample_ms * 1e6);
+
+    std::vector<double> per_iter;
+    double total_ns = 0;
+    while (int(per_iter.size()) < opt.samples) {
+        double ns = time_batch(engine, input, res.iterations);
+        per_iter.push_back(ns / double(res.iterations));
+        total_ns += ns;
+
+        if (int(per_iter.size()) >= MIN_SAMPLES && total_ns > opt.max_time_ms * 1e6)
+            break;
     }
 
-    std::string solver_arg = argv[1];
-    std::string filepath = argv[2];
+    res.stats = compute_stats(per_iter);
+
+    if (perf)
+        count_calls(engine, input, res.iterations, *perf, res);
+    // Os inválidos não são tempos de solve reais: fora do histograma
+    if (res.outcome != Outcome::INVALID_INPUT)
+        record_calls(engine, input, std::uint64_t(opt.hist_calls), latency);
+    // Só os boards resolvidos: os outros ficam com "-" nas colunas de memória
+    bool solved = res.outcome == Outcome::SOLVED || res.outcome == Outcome::WRONG_SOLUTION;
+    if (stack && solved)
+        probe_memory(engine, input, *stack, res);
+    return res;
+}
+
+// --------------------------------------------------
+// Saída
+
+static void print_header(FILE* out, bool perf, bool mem) {
+    std::fprintf(out, "%-14s %-34s %-13s %12s %12s %12s %12s %12s %12s %10s %4s",
+                 "engine", "board", "result", "iters x smp", "min_ns", "median_ns", "mean_ns",
+                 "p90_ns", "p99_ns", "stddev_ns", "out");
+    if (perf)
+        std::fprintf(out, " %12s %12s %5s %10s %10s %10s", "cycles", "instructions", "IPC",
+                     "br_miss", "l1d_miss", "llc_miss");
+    if (mem)
+        std::fprintf(out, " %8s %10s %9s", "allocs", "alloc_B", "stack_B");
+    std::fprintf(out, "\n");
+}
 
-    SolverType solver;
+// Um contador na tabela ("-" se não foi contado)
+static void print_counter(FILE* out, const Result& r, int c, int width) {
+    if (r.counted[c])
+        std::fprintf(out, " %*.0f", width, r.counters[c]);
+    else
+        std::fprintf(out, " %*s", width, "-");
+}
 
-    if (solver_arg == "unoptimized")
-        solver = SolverType::UNOPTIMIZED;
-    else if (solver_arg == "bitmasking")
-        solver = SolverType::BITMASKING;
-    else if (solver_arg == "bitmasking_fc")
-        solver = SolverType::BITMASKING_FC;
-    else if (solver_arg == "dlx")
-        solver = SolverType::DLX;
-    else {
-        std::cout << "Unknown solver: " << solver_arg << "\n";
-        return 1;
+static void print_row(FILE* out, const Result& r, bool perf, bool mem) {
+    const SampleStats& s = r.stats;
+    char runs[32];
+    std::snprintf(runs, sizeof(runs), "%llu x %zu",
+                  static_cast<unsigned long long>(r.iterations), s.samples);
+    std::fprintf(out, "%-14s %-34s %-13s %12s %12.1f %12.1f %12.1f %12.1f %12.1f %10.1f %4zu",
+                 r.engine->name, r.board.c_str(), outcome_name(r.outcome), runs,
+                 s.min, s.median, s.mean, s.p90, s.p99, s.stddev, s.outliers);
+    if (perf) {
+        print_counter(out, r, PERF_CYCLES, 12);
+        print_counter(out, r, PERF_INSTRUCTIONS, 12);
+        if (r.counted[PERF_CYCLES] && r.counted[PERF_INSTRUCTIONS] && r.counters[PERF_CYCLES] > 0)
+            std::fprintf(out, " %5.2f", r.counters[PERF_INSTRUCTIONS] / r.counters[PERF_CYCLES]);
+        else
+            std::fprintf(out, " %5s", "-");
+        print_counter(out, r, PERF_BRANCH_MISSES, 10);
+        print_counter(out, r, PERF_L1D_MISSES, 10);
+        print_counter(out, r, PERF_LLC_MISSES, 10);
     }
+    if (mem && r.mem_probed)
+        std::fprintf(out, " %8llu %10llu %9zu", static_cast<unsigned long long>(r.allocs),
+                     static_cast<unsigned long long>(r.alloc_bytes), r.stack_bytes);
+    else if (mem)
+        std::fprintf(out, " %8s %10s %9s", "-", "-", "-");
+    std::fprintf(out, "\n");
+    std::fflush(out);
+}
 
-    Board input;
-    if (read_file(input, filepath) != 0) {
-        std::cerr << "Failed to read board: " << filepath << "\n";
-        return 1;
+// Máximos por solver: alocações e bytes por solve, pilha
+static void print_memory_summary(FILE* out, const Options& opt,
+                                 const std::vector<Result>& results) {
+    std::fprintf(out, "\nMemory per solve call, worst board\n");
+    std::fprintf(out, "%-14s %10s %12s %12s  %s\n", "engine", "allocs", "alloc_bytes",
+                 "stack_bytes", "hot path");
+
+    for (const Engine* e : opt.engines) {
+        std::uint64_t allocs = 0, bytes = 0;
+        std::size_t stack = 0;
+        bool probed = false;
+        for (const Result& r : results) {
+            if (r.engine != e || !r.mem_probed)
+                continue;
+            probed = true;
+            allocs = std::max(allocs, r.allocs);
+            bytes = std::max(bytes, r.alloc_bytes);
+            stack = std::max(stack, r.stack_bytes);
+        }
+        // Nenhum board resolvido: não há medida, não "0 alocações"
+        if (!probed) {
+            std::fprintf(out, "%-14s %10s %12s %12s  %s\n", e->name, "-", "-", "-",
+                         "not probed");
+            continue;
+        }
+        std::fprintf(out, "%-14s %10llu %12llu %12zu  %s\n", e->name,
+                     static_cast<unsigned long long>(allocs),
+                     static_cast<unsigned long long>(bytes), stack,
+                     allocs == 0 ? "no allocations" : "ALLOCATES");
     }
+}
 
-    constexpr int ITERS = 50;
+static FILE* open_output(const char* path) {
+    return std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+}
 
-    Board solution;
+static void close_output(FILE* f) {
+    if (f != stdout)
+        std::fclose(f);
+}
 
-    // --------------------------------------------------
-    // Warm-up
+static int write_csv(const char* path, const std::vector<Result>& results) {
+    FILE* f = open_output(path);
+    if (!f)
+        return 1;
 
-    for (int i = 0; i < 5; i++) {
-        if (solver == SolverType::UNOPTIMIZED)
-            solve_unoptimized(input, solution);
-        else if (solver == SolverType::BITMASKING)
-            solve_bitmasking(input, solution);
-        else if (solver == SolverType::BITMASKING_FC)
-            solve_bitmasking_fc(input, solution);
+    std::fprintf(f, "engine,board,result,iterations,samples,min_ns,median_ns,mean_ns,"
+                    "p90_ns,p99_ns,max_ns,stddev_ns,outliers");
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++)
+        std::fprintf(f, ",%s", perf_counter_name(c));
+    std::fprintf(f, ",allocs,alloc_bytes,stack_bytes\n");
+    for (const Result& r : results) {
+        const SampleStats& s = r.stats;
+        std::fprintf(f, "%s,%s,%s,%llu,%zu,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%zu",
+                     r.engine->name, r.board.c_str(), outcome_name(r.outcome),
+                     static_cast<unsigned long long>(r.iterations), s.samples,
+                     s.min, s.median, s.mean, s.p90, s.p99, s.max, s.stddev, s.outliers);
+        // Contadores vazios se não foram medidos
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            if (r.counted[c])
+                std::fprintf(f, ",%.1f", r.counters[c]);
+            else
+                std::fprintf(f, ",");
+        }
+        if (r.mem_probed)
+            std::fprintf(f, ",%llu,%llu,%zu\n", static_cast<unsigned long long>(r.allocs),
+                         static_cast<unsigned long long>(r.alloc_bytes), r.stack_bytes);
         else
-            solve_dlx(input, solution);
+            std::fprintf(f, ",,,\n");
     }
 
-    // --------------------------------------------------
-    // Medição em bloco
+    close_output(f);
+    return 0;
+}
 
-    auto start = std::chrono::steady_clock::now();
+static int write_json(const char* path, const std::vector<Result>& results, const Options& opt) {
+    FILE* f = open_output(path);
+    if (!f)
+        return 1;
 
-    for (int i = 0; i < ITERS; i++) {
-        if (solver == SolverType::UNOPTIMIZED)
-            solve_unoptimized(input, solution);
-        else if (solver == SolverType::BITMASKING)
-            solve_bitmasking(input, solution);
-        else if (solver == SolverType::BITMASKING_FC)
-            solve_bitmasking_fc(input, solution);
+    std::fprintf(f, "{\n  \"config\": {\"samples\": %d, \"min_sample_ms\": %g, \"max_time_ms\": %g},\n",
+                 opt.samples, opt.min_sample_ms, opt.max_time_ms);
+    std::fprintf(f, "  \"results\": [\n");
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        const SampleStats& s = r.stats;
+        // Os nomes dos ficheiros de boards/ não têm aspas nem barras
+        std::fprintf(f,
+                     "    {\"engine\": \"%s\", \"board\": \"%s\", \"result\": \"%s\", "
+                     "\"iterations\": %llu, \"samples\": %zu, \"min_ns\": %.1f, \"median_ns\": %.1f, "
+                     "\"mean_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, "
+                     "\"stddev_ns\": %.1f, \"outliers\": %zu",
+                     r.engine->name, r.board.c_str(), outcome_name(r.outcome),
+                     static_cast<unsigned long long>(r.iterations), s.samples,
+                     s.min, s.median, s.mean, s.p90, s.p99, s.max, s.stddev, s.outliers);
+        // null se o contador não foi medido
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            if (r.counted[c])
+                std::fprintf(f, ", \"%s\": %.1f", perf_counter_name(c), r.counters[c]);
+            else
+                std::fprintf(f, ", \"%s\": null", perf_counter_name(c));
+        }
+        if (r.mem_probed)
+            std::fprintf(f, ", \"allocs\": %llu, \"alloc_bytes\": %llu, \"stack_bytes\": %zu",
+                         static_cast<unsigned long long>(r.allocs),
+                         static_cast<unsigned long long>(r.alloc_bytes), r.stack_bytes);
         else
-            solve_dlx(input, solution);
+            std::fprintf(f, ", \"allocs\": null, \"alloc_bytes\": null, \"stack_bytes\": null");
+        std::fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
     }
 
-    auto end = std::chrono::steady_clock::now();
+    std::fprintf(f, "  ]\n}\n");
+    close_output(f);
+    return 0;
+}
 
-    // --------------------------------------------------
-    // Validação
+// --------------------------------------------------
 
-    bool valid = validate_solution(input, solution);
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--no-perf") == 0) {
+            opt.perf = false;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--no-mem") == 0) {
+            opt.mem = false;
+            continue;
+        }
+        if (i + 1 >= argc)
+            return false;
 
-    auto total_us = std::chrono::duration_cast<std::chrono::microseconds>(
-        end - start
-    ).count();
+        const char* arg = argv[i];
+        const char* val = argv[++i];
 
-    double avg_us = double(total_us) / ITERS;
+        if (std::strcmp(arg, "--engine") == 0) {
+            const Engine* e = find_engine(val);
+            if (!e) {
+                std::fprintf(stderr, "Unknown engine: %s\n", val);
+                return false;
+            }
+            opt.engines.push_back(e);
+        } else if (std::strcmp(arg, "--board") == 0) {
+            opt.boards.push_back(val);
+        } else if (std::strcmp(arg, "--boards-dir") == 0) {
+            opt.boards_dir = val;
+        } else if (std::strcmp(arg, "--samples") == 0) {
+            opt.samples = std::atoi(val);
+        } else if (std::strcmp(arg, "--min-sample-ms") == 0) {
+            opt.min_sample_ms = std::atof(val);
+        } else if (std::strcmp(arg, "--max-time-ms") == 0) {
+            opt.max_time_ms = std::atof(val);
+        } else if (std::strcmp(arg, "--json") == 0) {
+            opt.json_path = val;
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            opt.csv_path = val;
+        } else if (std::strcmp(arg, "--hist") == 0) {
+            opt.hist_path = val;
+        } else if (std::strcmp(arg, "--hist-csv") == 0) {
+            opt.hist_csv_path = val;
+        } else if (std::strcmp(arg, "--hist-calls") == 0) {
+            opt.hist_calls = std::atoi(val);
+        } else {
+            return false;
+        }
+    }
 
-    // --------------------------------------------------
-    // Relatório
+    if (opt.engines.empty()) {
+        for (const Engine* e = engines_begin(); e != engines_end(); e++)
+            opt.engines.push_back(e);
+    }
+    if (opt.samples < MIN_SAMPLES)
+        opt.samples = MIN_SAMPLES;
+    if (opt.hist_calls < 1)
+        opt.hist_calls = 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--engine NAME]... [--board FILE]... [--boards-dir DIR]\n"
+                     "          [--samples N] [--min-sample-ms X] [--max-time-ms X]\n"
+                     "          [--json FILE|-] [--csv FILE|-] [--no-perf] [--no-mem]\n"
+                     "          [--hist FILE] [--hist-csv FILE|-] [--hist-calls N]\n"
+                     "Engines:", argv[0]);
+        for (const Engine* e = engines_begin(); e != engines_end(); e++)
+            std::fprintf(stderr, " %s", e->name);
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+
+    if (opt.boards.empty() && list_board_files(opt.boards_dir, opt.boards) != 0) {
+        std::fprintf(stderr, "Cannot read boards directory: %s\n", opt.boards_dir);
+        return 1;
+    }
+
+    // Se o JSON/CSV vai para o stdout, a tabela vai para o stderr
+    bool machine_stdout = (opt.json_path && std::strcmp(opt.json_path, "-") == 0) ||
+                          (opt.csv_path && std::strcmp(opt.csv_path, "-") == 0) ||
+                          (opt.hist_csv_path && std::strcmp(opt.hist_csv_path, "-") == 0);
+    FILE* table = machine_stdout ? stderr : stdout;
+
+    // Contadores da thread principal, que é a que chama os solvers
+    PerfCounters perf;
+    bool use_perf = false;
+    if (opt.perf) {
+        use_perf = perf.open() == 0;
+        if (!use_perf)
+            perf_counters_explain(perf.error());
+    }
+
+    // Pilha para a passagem de memória (mem_probe.hpp)
+    StackProbe stack;
+    bool use_mem = opt.mem && stack.available();
+
+    std::fprintf(table, "Benchmark report\n");
+    std::fprintf(table, "-----------------------------\n");
+    std::fprintf(table, "Engines    : %zu\n", opt.engines.size());
+    std::fprintf(table, "Boards     : %zu\n", opt.boards.size());
+    std::fprintf(table, "Dispatch   : %s (common/cpu_dispatch.hpp)\n", cpu_dispatch_level());
+    std::fprintf(table, "Samples    : %d (>= %.1f ms each, <= %.0f ms per pair)\n",
+                 opt.samples, opt.min_sample_ms, opt.max_time_ms);
+    std::fprintf(table, "HW counters: %s\n", use_perf ? "per solve call (user space)" : "off");
+    std::fprintf(table, "Memory     : %s\n\n",
+                 use_mem ? "heap allocations and peak stack per solve call" : "off");
+    print_header(table, use_perf, use_mem);
+
+    std::vector<Result> results;
+    LatencyReport latency;
+    bool wrong = false;
+
+    for (const Engine* e : opt.engines) {
+        for (const std::string& board : opt.boards) {
+            Result r = run_pair(*e, board, opt, use_perf ? &perf : nullptr,
+                                use_mem ? &stack : nullptr, latency);
+            wrong = wrong || r.outcome == Outcome::WRONG_SOLUTION;
+            print_row(table, r, use_perf, use_mem);
+            results.push_back(r);
+        }
+    }
+
+    if (opt.csv_path && write_csv(opt.csv_path, results) != 0) {
+        std::fprintf(stderr, "Cannot write %s\n", opt.csv_path);
+        return 1;
+    }
+    if (opt.json_path && write_json(opt.json_path, results, opt) != 0) {
+        std::fprintf(stderr, "Cannot write %s\n", opt.json_path);
+        return 1;
+    }
+    if (opt.hist_path && latency.save(opt.hist_path) != 0) {
+        std::fprintf(stderr, "Cannot write %s\n", opt.hist_path);
+        return 1;
+    }
+    if (opt.hist_csv_path && latency.write_csv(opt.hist_csv_path) != 0) {
+        std::fprintf(stderr, "Cannot write %s\n", opt.hist_csv_path);
+        return 1;
+    }
 
-    std::cout << "Benchmark report\n";
-    std::cout << "-----------------------------\n";
-    std::cout << "Solver     : " << solver_name(solver) << "\n";
-    std::cout << "Board file : " << filepath << "\n";
-    std::cout << "Iterations : " << ITERS << "\n\n";
+    std::fprintf(table, "\nLatency per call, by difficulty class (clue count)\n");
+    latency.print(table);
 
-    std::cout << "Total time : " << total_us << " us\n";
-    std::cout << "Avg / run  : " << avg_us << " us\n";
-    std::cout << "Avg / run  : " << avg_us / 1000.0 << " ms\n\n";
+    if (use_mem)
+        print_memory_summary(table, opt, results);
 
-    std::cout << "Solution valid: " << (valid ? "YES" : "NO") << "\n";
+    if (wrong)
+        std::fprintf(table, "\nSome solvers returned an invalid solution (result WRONG)\n");
 
-    return valid ? 0 : 2;
+    return wrong ? 2 : 0;
 }
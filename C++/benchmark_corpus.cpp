@@ -0,0 +1,195 @@
+#include "common/board_packed.hpp"
+#include "common/engines.hpp"
+#include "common/latency_histogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// --------------------------------------------------
+// Puzzles por segundo de cada solver em cada tier do corpus
+// (ficheiros gerados por build_corpus.sh, um tabuleiro por linha).
+//
+// Cada tier é resolvido por inteiro, uma vez, com o tempo de cada puzzle
+// num histograma (latency_histogram.hpp). As soluções são verificadas.
+//
+// Uso: ./benchmark_corpus.exe [--engine NOME]... [--csv FICHEIRO|-] [ficheiro...]
+// Sem ficheiros: corpus/easy.txt corpus/hard.txt corpus/minimal.txt
+
+using Clock = std::chrono::steady_clock;
+
+struct TierResult {
+    const Engine* engine = nullptr;
+    std::string tier;
+    std::size_t boards = 0;
+    std::size_t solved = 0;
+    std::size_t wrong = 0;
+    double seconds = 0;
+    LatencyHistogram latency;
+};
+
+static bool valid_solution(const Board& puzzle, const Board& solution) {
+    std::uint16_t rows[9] = {};
+    std::uint16_t cols[9] = {};
+    std::uint16_t boxes[9] = {};
+
+    for (int i = 0; i < 81; i++) {
+        int v = solution.cells[i];
+        if (v < 1 || v > 9 || (puzzle.cells[i] != 0 && puzzle.cells[i] != v))
+            return false;
+
+        std::uint16_t bit = static_cast<std::uint16_t>(1u << v);
+        int b = (i / 27) * 3 + (i % 9) / 3;
+        if ((rows[i / 9] | cols[i % 9] | boxes[b]) & bit)
+            return false;
+        rows[i / 9] |= bit;
+        cols[i % 9] |= bit;
+        boxes[b] |= bit;
+    }
+    return true;
+}
+
+// "corpus/hard.txt" -> "hard"
+static std::string tier_name(const std::string& path) {
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    std::size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+static TierResult run_tier(const Engine& engine, const std::string& tier,
+                           const std::vector<Board>& boards) {
+    TierResult res;
+    res.engine = &engine;
+    res.tier = tier;
+    res.boards = boards.size();
+
+    Board solution;
+    auto start = Clock::now();
+
+    for (const Board& b : boards) {
+        auto t0 = Clock::now();
+        int found = engine.solve(b, solution);
+        auto t1 = Clock::now();
+        res.latency.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+
+        if (found != 1)
+            continue;
+        if (valid_solution(b, solution))
+            res.solved++;
+        else
+            res.wrong++;
+    }
+
+    res.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return res;
+}
+
+static void print_row(FILE* out, const TierResult& r) {
+    const LatencyHistogram& h = r.latency;
+    std::fprintf(out, "%-14s %-10s %9zu %9zu %6zu %12.0f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                 r.engine->name, r.tier.c_str(), r.boards, r.solved, r.wrong,
+                 double(r.boards) / r.seconds, h.mean() / 1e3, double(h.percentile(50)) / 1e3,
+                 double(h.percentile(99)) / 1e3, double(h.percentile(99.9)) / 1e3,
+                 double(h.max()) / 1e3);
+    std::fflush(out);
+}
+
+static int write_csv(const char* path, const std::vector<TierResult>& results) {
+    FILE* f = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+    if (!f)
+        return 1;
+
+    std::fprintf(f, "engine,tier,boards,solved,wrong,puzzles_per_s,mean_ns,p50_ns,p99_ns,"
+                    "p999_ns,max_ns\n");
+    for (const TierResult& r : results) {
+        const LatencyHistogram& h = r.latency;
+        std::fprintf(f, "%s,%s,%zu,%zu,%zu,%.1f,%.1f,%llu,%llu,%llu,%llu\n", r.engine->name,
+                     r.tier.c_str(), r.boards, r.solved, r.wrong, double(r.boards) / r.seconds,
+                     h.mean(), static_cast<unsigned long long>(h.percentile(50)),
+                     static_cast<unsigned long long>(h.percentile(99)),
+                     static_cast<unsigned long long>(h.percentile(99.9)),
+                     static_cast<unsigned long long>(h.max()));
+    }
+
+    if (f != stdout)
+        std::fclose(f);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<const Engine*> engines;
+    std::vector<std::string> files;
+    const char* csv_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            const Engine* e = find_engine(argv[++i]);
+            if (!e) {
+                std::fprintf(stderr, "Unknown engine: %s\n", argv[i]);
+                return 1;
+            }
+            engines.push_back(e);
+        } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (std::strncmp(argv[i], "--", 2) == 0) {
+            std::fprintf(stderr, "Usage: %s [--engine NAME]... [--csv FILE|-] [tier_file...]\n",
+                         argv[0]);
+            return 1;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (engines.empty()) {
+        for (const Engine* e = engines_begin(); e != engines_end(); e++)
+            engines.push_back(e);
+    }
+    if (files.empty())
+        files = {"corpus/easy.txt", "corpus/hard.txt", "corpus/minimal.txt"};
+
+    FILE* table = csv_path && std::strcmp(csv_path, "-") == 0 ? stderr : stdout;
+    std::fprintf(table, "%-14s %-10s %9s %9s %6s %12s %10s %10s %10s %10s %10s\n", "engine",
+                 "tier", "boards", "solved", "wrong", "puzzles/s", "mean_us", "p50_us",
+                 "p99_us", "p99.9_us", "max_us");
+
+    std::vector<TierResult> results;
+    bool wrong = false;
+
+    for (const std::string& file : files) {
+        std::vector<Board> boards;
+        if (load_boards(file, boards) != 0) {
+            std::fprintf(stderr, "Error reading file: %s (run ./build_corpus.sh first)\n",
+                         file.c_str());
+            return 1;
+        }
+
+        for (const Engine* e : engines) {
+            TierResult r = run_tier(*e, tier_name(file), boards);
+            wrong = wrong || r.wrong != 0;
+            print_row(table, r);
+            results.push_back(r);
+        }
+    }
+
+    if (csv_path && write_csv(csv_path, results) != 0) {
+        std::fprintf(stderr, "Cannot write %s\n", csv_path);
+        return 1;
+    }
+
+    // Os puzzles do corpus têm todos solução única: avisa quem não a encontrou
+    bool header = false;
+    for (const TierResult& r : results) {
+        if (r.solved == r.boards)
+            continue;
+        if (!header)
+            std::fprintf(table, "\n");
+        header = true;
+        std::fprintf(table, "%s solved %zu of %zu %s puzzles\n", r.engine->name, r.solved,
+                     r.boards, r.tier.c_str());
+    }
+    return wrong ? 2 : 0;
+}
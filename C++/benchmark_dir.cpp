@@ -0,0 +1,190 @@
+#include "unoptimized/sudoku_unoptimize.hpp"
+#include "common/board_dir.hpp"
+#include "common/board_packed.hpp"
+#include "common/board_parse.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Benchmark do carregamento de um diretório de ficheiros .sudoku:
+//   ifstream   : read_file() de sempre, um ficheiro de cada vez
+//   raw        : read_file_raw(), um ficheiro de cada vez
+//   threads    : pool de threads com pread
+//   io_uring   : open/read/close em lote
+//
+// Uso: ./benchmark_dir.exe [--create ficheiro_de_linhas] <diretório> [repetições]
+// Com --create, o diretório é primeiro preenchido com um ficheiro de
+// 9 linhas por tabuleiro do ficheiro de linhas.
+//
+// Nota: os tempos são com os ficheiros em page cache (a partir da 2ª passagem);
+// para medir a frio é preciso "echo 3 > /proc/sys/vm/drop_caches" (root).
+
+using Clock = std::chrono::steady_clock;
+
+static int create_board_dir(const char* lines_file, const std::string& dir) {
+    std::vector<Board> boards;
+    if (load_boards(lines_file, boards) != 0)
+        return 1;
+
+    mkdir(dir.c_str(), 0755);
+
+    for (std::size_t i = 0; i < boards.size(); i++) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%07zu.sudoku", i);
+        std::string path = dir + name;
+
+        // Mesmo formato dos ficheiros em boards/: 9 linhas, sem '\n' no fim
+        char text[89];
+        std::size_t pos = 0;
+        for (int r = 0; r < 9; r++) {
+            for (int c = 0; c < 9; c++)
+                text[pos++] = static_cast<char>('0' + boards[i].cells[r * 9 + c]);
+            if (r < 8)
+                text[pos++] = '\n';
+        }
+
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+            return 1;
+        ssize_t n = write(fd, text, pos);
+        close(fd);
+        if (n != static_cast<ssize_t>(pos))
+            return 1;
+    }
+
+    std::printf("Created %zu files in %s\n", boards.size(), dir.c_str());
+    return 0;
+}
+
+template <typename LoadFn>
+static double time_load(const char* name, int reps, std::size_t files,
+                        std::vector<Board>& boards, std::vector<std::uint8_t>& ok,
+                        LoadFn load) {
+    load(boards, ok); // aquece a page cache e os dentries
+
+    long loaded = 0;
+    auto start = Clock::now();
+    for (int r = 0; r < reps; r++)
+        loaded = load(boards, ok);
+    auto end = Clock::now();
+
+    if (loaded < 0) {
+        std::printf("%-9s : not available\n", name);
+        return -1;
+    }
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / reps;
+    std::printf("%-9s : %10.2f ms, %7.2f us/file, %10.0f files/s (%ld ok)\n",
+                name, ns / 1e6, ns / 1e3 / double(files), double(files) / (ns / 1e9), loaded);
+    return ns;
+}
+
+int main(int argc, char* argv[]) {
+    int arg = 1;
+    const char* create_from = nullptr;
+
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--create") == 0) {
+        create_from = argv[arg + 1];
+        arg += 2;
+    }
+
+    if (arg >= argc) {
+        std::fprintf(stderr, "Usage: %s [--create lines_file] <dir> [reps]\n", argv[0]);
+        return 1;
+    }
+
+    std::string dir = argv[arg];
+    int reps = arg + 1 < argc ? std::atoi(argv[arg + 1]) : 5;
+    if (reps < 1)
+        reps = 1;
+
+    if (create_from && create_board_dir(create_from, dir) != 0) {
+        std::fprintf(stderr, "Failed to create %s from %s\n", dir.c_str(), create_from);
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    if (list_board_files(dir, paths) != 0 || paths.empty()) {
+        std::fprintf(stderr, "No .sudoku files in %s\n", dir.c_str());
+        return 1;
+    }
+
+    std::printf("Directory load benchmark\n");
+    std::printf("-----------------------------\n");
+    std::printf("Files      : %zu\n", paths.size());
+    std::printf("Repeats    : %d\n", reps);
+    std::printf("io_uring   : %s\n\n", io_uring_available() ? "yes" : "no");
+
+    std::vector<Board> ref_boards, boards;
+    std::vector<std::uint8_t> ref_ok, ok;
+
+    double base = time_load("ifstream", reps, paths.size(), ref_boards, ref_ok,
+                            [&](std::vector<Board>& b, std::vector<std::uint8_t>& k) {
+        b.assign(paths.size(), Board{});
+        k.assign(paths.size(), 0);
+        long loaded = 0;
+        for (std::size_t i = 0; i < paths.size(); i++) {
+            if (read_file(b[i], paths[i]) == 0) {
+                k[i] = 1;
+                loaded++;
+            } else {
+                b[i] = Board{};
+            }
+        }
+        return loaded;
+    });
+
+    struct Variant {
+        const char* name;
+        int kind; // 0 = raw, 1 = threads, 2 = io_uring
+    };
+    const Variant variants[] = {{"raw", 0}, {"threads", 1}, {"io_uring", 2}};
+
+    bool same = true;
+    for (const Variant& v : variants) {
+        double ns = time_load(v.name, reps, paths.size(), boards, ok,
+                              [&](std::vector<Board>& b, std::vector<std::uint8_t>& k) -> long {
+            if (v.kind == 1)
+                return load_board_files(paths, b, k, DirLoadMethod::THREADS);
+            if (v.kind == 2)
+                return load_board_files(paths, b, k, DirLoadMethod::IO_URING);
+
+            b.assign(paths.size(), Board{});
+            k.assign(paths.size(), 0);
+            long loaded = 0;
+            for (std::size_t i = 0; i < paths.size(); i++) {
+                if (read_file_raw(b[i], paths[i].c_str()) == 0) {
+                    k[i] = 1;
+                    loaded++;
+                } else {
+                    b[i] = Board{};
+                }
+            }
+            return loaded;
+        });
+
+        if (ns < 0)
+            continue;
+
+        bool match = ok == ref_ok;
+        for (std::size_t i = 0; match && i < boards.size(); i++)
+            match = !ok[i] || boards[i].cells == ref_boards[i].cells;
+        if (!match)
+            std::printf("%-9s : output differs from ifstream\n", v.name);
+        same = same && match;
+
+        std::printf("%-9s   speedup vs ifstream: %.2fx\n", "", base / ns);
+    }
+
+    std::printf("\nOutput match: %s\n", same ? "YES" : "NO");
+    return same ? 0 : 2;
+}
@@ -0,0 +1,170 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/board_parse.hpp"
+#include "common/board_packed.hpp"
+
+// --------------------------------------------------
+// Benchmark só do parsing: SIMD vs escalar sobre o mesmo buffer.
+// Uso: ./benchmark_parse.exe [ficheiro_de_linhas] [repetições]
+// Sem ficheiro, usa os tabuleiros resolúveis de ../boards.
+
+static const char* DEFAULT_BOARDS[] = {
+    "../boards/fully-solved.sudoku",
+    "../boards/solvable-2x-hard.sudoku",
+    "../boards/solvable-easy-1.sudoku",
+    "../boards/solvable-example-1.sudoku",
+    "../boards/solvable-extra-hard-1.sudoku",
+    "../boards/solvable-hard-1.sudoku",
+    "../boards/solvable-medium-1.sudoku",
+};
+
+static constexpr int DEFAULT_LINES = 100000;
+
+// Converte um ficheiro de 9 linhas numa linha de 81 caracteres
+static bool board_file_to_line(const std::string& path, std::string& line) {
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    line.clear();
+    char c;
+    while (line.size() < 81 && file.get(c)) {
+        if ((c >= '0' && c <= '9') || c == '.')
+            line.push_back(c);
+    }
+    return line.size() == 81;
+}
+
+static bool build_input(int argc, char* argv[], std::string& text) {
+    if (argc >= 2) {
+        std::ifstream file(argv[1], std::ios::binary);
+        if (!file.is_open())
+            return false;
+        text.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    std::vector<std::string> lines;
+    for (const char* path : DEFAULT_BOARDS) {
+        std::string line;
+        if (board_file_to_line(path, line))
+            lines.push_back(line);
+    }
+    if (lines.empty())
+        return false;
+
+    text.reserve(DEFAULT_LINES * 82);
+    for (int i = 0; i < DEFAULT_LINES; i++) {
+        text += lines[i % lines.size()];
+        text += '\n';
+    }
+    return true;
+}
+
+template <typename ParseFn>
+static long parse_all(const std::vector<char>& buf, std::size_t size,
+                      std::vector<Board>& out, ParseFn parse) {
+    out.clear();
+    std::size_t pos = 0;
+    while (pos < size) {
+        if (buf[pos] == '\n') {
+            pos++;
+            continue;
+        }
+        Board b;
+        int used = parse(buf.data() + pos, size - pos, b);
+        if (used < 0)
+            return -1;
+        out.push_back(b);
+        pos += static_cast<std::size_t>(used);
+    }
+    return static_cast<long>(out.size());
+}
+
+template <typename ParseFn>
+static double time_parse(const char* name, const std::vector<char>& buf,
+                         std::size_t size, int reps,
+                         std::vector<Board>& out, ParseFn parse) {
+    parse_all(buf, size, out, parse); // warm-up
+
+    auto start = std::chrono::steady_clock::now();
+    long count = 0;
+    for (int r = 0; r < reps; r++)
+        count += parse_all(buf, size, out, parse);
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    double per_board = ns / double(count);
+    double mb_s = (double(size) * reps) / (ns / 1e9) / 1e6;
+
+    std::cout << name << " : " << per_board << " ns/board, "
+              << mb_s << " MB/s\n";
+    return per_board;
+}
+
+int main(int argc, char* argv[]) {
+    std::string text;
+    if (!build_input(argc, argv, text)) {
+        std::cerr << "Failed to build parse input\n";
+        return 1;
+    }
+
+    int reps = argc >= 3 ? std::stoi(argv[2]) : 20;
+
+    // padding para as leituras de 96 bytes
+    std::vector<char> buf(text.size() + PARSE_WINDOW, 0);
+    std::memcpy(buf.data(), text.data(), text.size());
+
+    std::vector<Board> simd_out;
+    std::vector<Board> scalar_out;
+    simd_out.reserve(text.size() / 81 + 1);
+    scalar_out.reserve(text.size() / 81 + 1);
+
+    if (parse_all(buf, text.size(), scalar_out, parse_board_line_scalar) < 0) {
+        std::cerr << "Input contains an invalid line\n";
+        return 1;
+    }
+
+    std::cout << "Parse benchmark report\n";
+    std::cout << "-----------------------------\n";
+    std::cout << "Boards     : " << scalar_out.size() << "\n";
+    std::cout << "Bytes      : " << text.size() << "\n";
+    std::cout << "Repeats    : " << reps << "\n";
+    std::cout << "SIMD impl  : " << parse_board_impl() << "\n\n";
+
+    double scalar_ns = time_parse("Scalar", buf, text.size(), reps,
+                                  scalar_out, parse_board_line_scalar);
+    double simd_ns = time_parse("SIMD  ", buf, text.size(), reps,
+                                simd_out, parse_board_line);
+
+    bool same = simd_out.size() == scalar_out.size();
+    for (std::size_t i = 0; same && i < simd_out.size(); i++)
+        same = simd_out[i].cells == scalar_out[i].cells;
+
+    // Formato compacto: unpack de 41 bytes em vez de parse de 82
+    std::vector<PackedBoard> packed(scalar_out.size());
+    for (std::size_t i = 0; i < scalar_out.size(); i++)
+        pack_board(scalar_out[i], packed[i]);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+        for (std::size_t i = 0; i < packed.size(); i++)
+            unpack_board(packed[i], simd_out[i]);
+    auto end = std::chrono::steady_clock::now();
+
+    double unpack_ns = std::chrono::duration<double, std::nano>(end - start).count() /
+                       (double(packed.size()) * reps);
+    std::cout << "Unpack : " << unpack_ns << " ns/board ("
+              << PACKED_BOARD_SIZE << " bytes/board)\n";
+
+    std::cout << "\nSpeedup    : " << scalar_ns / simd_ns << "x\n";
+    std::cout << "Output match: " << (same ? "YES" : "NO") << "\n";
+
+    return same ? 0 : 2;
+}
@@ -0,0 +1,58 @@
+#!/bin/bash
+# Compares the normal (-O2), LTO and PGO + LTO builds of benchmark_corpus.exe,
+# engine by engine. The PGO build is trained on corpus/train (seed 2), the
+# measured corpus comes from build_corpus.sh (seed 1), so no training puzzle
+# is measured.
+#
+#   ./benchmark_pgo.sh [rounds] [benchmark_corpus options and tier files...]
+#   ./benchmark_pgo.sh 5 --engine dlx --engine bitmasking corpus/hard.txt
+#
+# The three builds run one after the other in each round (default 3) and the
+# best puzzles/s of the rounds is kept. Table on stdout, CSV in bench_pgo.csv.
+
+set -e
+
+ROUNDS=3
+if [[ $1 =~ ^[0-9]+$ ]]; then
+  ROUNDS=$1
+  shift
+fi
+
+cd "$(dirname "$0")"
+make -s benchmark_corpus benchmark_corpus_lto benchmark_corpus_pgo
+
+BUILDS="base lto pgo"
+declare -A EXE=([base]=benchmark_corpus.exe [lto]=benchmark_corpus_lto.exe [pgo]=benchmark_corpus_pgo.exe)
+rm -f bench_pgo_*_*.csv
+
+for ((r = 1; r <= ROUNDS; r++)); do
+  for b in $BUILDS; do
+    echo "[INFO] Round $r/$ROUNDS: $b"
+    # 2: some engine returned a wrong solution (hybrid); the timing still counts
+    ./${EXE[$b]} --csv "bench_pgo_${b}_${r}.csv" "$@" > /dev/null || [ $? -eq 2 ]
+  done
+done
+
+awk -F, '
+  FNR == 1 { split(FILENAME, part, "_"); build = part[3]; next }
+  {
+    key = $1 "," $2
+    if (!(key in seen)) { seen[key] = 1; order[n++] = key }
+    if ($6 > best[key, build]) best[key, build] = $6
+  }
+  END {
+    printf "%-14s %-10s %12s %12s %12s %8s %8s\n", "engine", "tier", "O2 p/s", "LTO p/s",
+           "PGO p/s", "LTO", "PGO" > "/dev/stdout"
+    print "engine,tier,base_puzzles_per_s,lto_puzzles_per_s,pgo_puzzles_per_s,lto_gain_pct,pgo_gain_pct" > "bench_pgo.csv"
+    for (i = 0; i < n; i++) {
+      k = order[i]
+      split(k, id, ",")
+      base = best[k, "base"]; lto = best[k, "lto"]; pgo = best[k, "pgo"]
+      lg = base > 0 ? (lto / base - 1) * 100 : 0
+      pg = base > 0 ? (pgo / base - 1) * 100 : 0
+      printf "%-14s %-10s %12.0f %12.0f %12.0f %+7.1f%% %+7.1f%%\n", id[1], id[2], base, lto, pgo, lg, pg
+      printf "%s,%s,%.1f,%.1f,%.1f,%.2f,%.2f\n", id[1], id[2], base, lto, pgo, lg, pg > "bench_pgo.csv"
+    }
+  }' bench_pgo_*_*.csv
+
+rm -f bench_pgo_*_*.csv
@@ -0,0 +1,283 @@
+#include "common/board_packed.hpp"
+#include "common/engines.hpp"
+#include "common/cpu_dispatch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+// --------------------------------------------------
+// Escalabilidade com o número de threads: o mesmo corpus resolvido com
+// 1, 2, 4, ... N threads, cada uma fixa num CPU.
+//
+// As threads tiram blocos de --chunk tabuleiros de um índice atómico (como
+// os lotes do pipeline), por isso o trabalho fica equilibrado mesmo com
+// tabuleiros de custo muito diferente; o desequilíbrio que sobra
+// (tempo da thread mais lenta / média) vem do fim da corrida ou de threads
+// que andam mais devagar (partilha de cache, alocador, SMT, ...).
+//
+// Para cada solver e número de threads (melhor de --reps corridas):
+//   puzzles/s, speedup e eficiência (speedup / threads) face a 1 thread,
+//   desequilíbrio e mínimo/máximo de tabuleiros por thread.
+// Os resultados vão também para benchmark_scaling_results.csv
+// (ao lado de benchmark_results.csv).
+//
+// Uso: ./benchmark_scaling.exe [--engine NOME]... [--threads N] [--reps R]
+//                              [--chunk C] [--no-pin] [--csv FICHEIRO|-]
+//                              [ficheiro_de_tabuleiros]
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr const char* DEFAULT_CSV = "benchmark_scaling_results.csv";
+static constexpr const char* DEFAULT_CORPUS = "corpus/minimal.txt";
+
+struct Options {
+    std::vector<const Engine*> engines;
+    unsigned max_threads = 0;
+    int reps = 3;
+    std::size_t chunk = 64;
+    bool pin = true;
+    const char* csv_path = DEFAULT_CSV;
+    const char* corpus = DEFAULT_CORPUS;
+};
+
+// Contadores de cada thread, cada um na sua linha de cache
+struct alignas(64) ThreadStats {
+    std::uint64_t busy_ns = 0;
+    std::uint64_t boards = 0;
+    std::uint64_t solved = 0;
+};
+
+struct RunResult {
+    unsigned threads = 0;
+    double seconds = 0;
+    std::uint64_t solved = 0;
+    double imbalance = 0; // busy máximo / busy médio
+    std::uint64_t min_boards = 0;
+    std::uint64_t max_boards = 0;
+};
+
+// CPUs onde o processo pode correr (respeita taskset/cgroups)
+static std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &set))
+                cpus.push_back(c);
+        }
+    }
+    return cpus;
+}
+
+static void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static RunResult run_once(const Engine& engine, const std::vector<Board>& boards,
+                          std::vector<Board>& solutions, unsigned threads,
+                          const std::vector<int>& cpus, const Options& opt) {
+    std::vector<ThreadStats> stats(threads);
+    std::atomic<std::size_t> next{0};
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            if (opt.pin && !cpus.empty())
+                pin_to_cpu(cpus[t % cpus.size()]);
+
+            // Todas as threads começam ao mesmo tempo
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+
+            ThreadStats& st = stats[t];
+            auto t0 = Clock::now();
+
+            for (;;) {
+                std::size_t begin = next.fetch_add(opt.chunk, std::memory_order_relaxed);
+                if (begin >= boards.size())
+                    break;
+                std::size_t end = std::min(begin + opt.chunk, boards.size());
+
+                for (std::size_t i = begin; i < end; i++) {
+                    if (engine.solve(boards[i], solutions[i]) == 1)
+                        st.solved++;
+                }
+                st.boards += end - begin;
+            }
+
+            st.busy_ns = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+        });
+    }
+
+    while (ready.load() != threads)
+        std::this_thread::yield();
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+
+    for (std::thread& w : workers)
+        w.join();
+
+    RunResult r;
+    r.threads = threads;
+    r.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    r.min_boards = UINT64_MAX;
+
+    double busy_sum = 0;
+    double busy_max = 0;
+    for (const ThreadStats& st : stats) {
+        r.solved += st.solved;
+        r.min_boards = std::min(r.min_boards, st.boards);
+        r.max_boards = std::max(r.max_boards, st.boards);
+        busy_sum += double(st.busy_ns);
+        busy_max = std::max(busy_max, double(st.busy_ns));
+    }
+    r.imbalance = busy_sum > 0 ? busy_max / (busy_sum / threads) : 1.0;
+    return r;
+}
+
+static std::vector<unsigned> thread_counts(unsigned max_threads) {
+    std::vector<unsigned> counts;
+    for (unsigned t = 1; t < max_threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max_threads);
+    return counts;
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+
+        if (std::strcmp(arg, "--no-pin") == 0) {
+            opt.pin = false;
+        } else if (std::strncmp(arg, "--", 2) != 0) {
+            opt.corpus = arg;
+        } else if (i + 1 >= argc) {
+            return false;
+        } else if (std::strcmp(arg, "--engine") == 0) {
+            const Engine* e = find_engine(argv[++i]);
+            if (!e) {
+                std::fprintf(stderr, "Unknown engine: %s\n", argv[i]);
+                return false;
+            }
+            opt.engines.push_back(e);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            opt.max_threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--reps") == 0) {
+            opt.reps = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--chunk") == 0) {
+            opt.chunk = static_cast<std::size_t>(std::atol(argv[++i]));
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            opt.csv_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    if (opt.engines.empty()) {
+        for (const Engine* e = engines_begin(); e != engines_end(); e++)
+            opt.engines.push_back(e);
+    }
+    if (opt.reps < 1)
+        opt.reps = 1;
+    if (opt.chunk == 0)
+        opt.chunk = 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--engine NAME]... [--threads N] [--reps R] [--chunk C]\n"
+                     "          [--no-pin] [--csv FILE|-] [boards_file]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Board> boards;
+    if (load_boards(opt.corpus, boards) != 0 || boards.empty()) {
+        std::fprintf(stderr, "Error reading file: %s (see build_corpus.sh)\n", opt.corpus);
+        return 1;
+    }
+    std::vector<Board> solutions(boards.size());
+    std::vector<int> cpus = allowed_cpus();
+    if (opt.max_threads == 0)
+        opt.max_threads = cpus.empty() ? 1 : static_cast<unsigned>(cpus.size());
+
+    FILE* csv = std::strcmp(opt.csv_path, "-") == 0 ? stdout : std::fopen(opt.csv_path, "w");
+    if (!csv) {
+        std::fprintf(stderr, "Cannot write %s\n", opt.csv_path);
+        return 1;
+    }
+    FILE* table = csv == stdout ? stderr : stdout;
+
+    std::fprintf(csv, "engine,threads,boards,solved,seconds,puzzles_per_s,speedup,efficiency,"
+                      "imbalance,min_thread_boards,max_thread_boards,pinned\n");
+
+    std::fprintf(table, "Scaling report\n");
+    std::fprintf(table, "-----------------------------\n");
+    std::fprintf(table, "Boards     : %zu (%s)\n", boards.size(), opt.corpus);
+    std::fprintf(table, "CPUs       : %zu allowed, threads pinned: %s\n", cpus.size(),
+                 opt.pin ? "yes" : "no");
+    std::fprintf(table, "Runs       : best of %d, chunks of %zu boards\n", opt.reps, opt.chunk);
+    std::fprintf(table, "Dispatch   : %s\n\n", cpu_dispatch_level());
+    std::fprintf(table, "%-14s %7s %12s %8s %10s %9s %15s\n", "engine", "threads", "puzzles/s",
+                 "speedup", "efficiency", "imbalance", "boards/thread");
+
+    for (const Engine* e : opt.engines) {
+        double base_rate = 0;
+
+        for (unsigned threads : thread_counts(opt.max_threads)) {
+            RunResult best;
+            for (int rep = 0; rep < opt.reps; rep++) {
+                RunResult r = run_once(*e, boards, solutions, threads, cpus, opt);
+                if (rep == 0 || r.seconds < best.seconds)
+                    best = r;
+            }
+
+            double rate = double(boards.size()) / best.seconds;
+            if (threads == 1)
+                base_rate = rate;
+            double speedup = base_rate > 0 ? rate / base_rate : 0;
+            double efficiency = speedup / threads;
+
+            char per_thread[32];
+            std::snprintf(per_thread, sizeof(per_thread), "%llu-%llu",
+                          static_cast<unsigned long long>(best.min_boards),
+                          static_cast<unsigned long long>(best.max_boards));
+            std::fprintf(table, "%-14s %7u %12.0f %7.2fx %9.1f%% %9.3f %15s\n", e->name, threads,
+                         rate, speedup, 100.0 * efficiency, best.imbalance, per_thread);
+            std::fflush(table);
+
+            std::fprintf(csv, "%s,%u,%zu,%llu,%.6f,%.1f,%.3f,%.3f,%.3f,%llu,%llu,%d\n", e->name,
+                         threads, boards.size(), static_cast<unsigned long long>(best.solved),
+                         best.seconds, rate, speedup, efficiency, best.imbalance,
+                         static_cast<unsigned long long>(best.min_boards),
+                         static_cast<unsigned long long>(best.max_boards), opt.pin ? 1 : 0);
+        }
+    }
+
+    if (csv != stdout)
+        std::fclose(csv);
+    if (!cpus.empty() && opt.max_threads > cpus.size())
+        std::fprintf(table, "\nNote: more threads than allowed CPUs, efficiency is capped\n");
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <glob.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Latência de arranque: tempo desde o posix_spawn até o processo terminar
+// (exec, linker dinâmico, inicializações estáticas, leitura do tabuleiro,
+// solve, saída e exit), para um tabuleiro por processo como benchmark.py.
+//
+// Compara os executáveis dados (por omissão todos os sudoku_*.exe e
+// lean_*.exe da pasta) com o mesmo tabuleiro. As corridas são intercaladas
+// (uma de cada executável por volta), para que variações do sistema afetem
+// todos igualmente. stdout/stderr dos filhos vão para /dev/null.
+//
+// Por executável: mínimo, mediana e p90 do tempo de parede, CPU médio
+// (user + sys, de wait4) e RSS máximo.
+//
+// Uso: ./benchmark_startup.exe [--runs N] [--warmup W] [--board FICHEIRO]
+//                              [--csv FICHEIRO|-] [executável...]
+
+extern char** environ;
+
+static constexpr const char* DEFAULT_BOARD = "../boards/solvable-hard-1.sudoku";
+
+struct Options {
+    int runs = 200;
+    int warmup = 5;
+    const char* board = DEFAULT_BOARD;
+    const char* csv_path = nullptr;
+    std::vector<std::string> exes;
+};
+
+struct Target {
+    std::string exe;
+    std::vector<std::uint64_t> wall_ns;
+    std::uint64_t cpu_us = 0; // soma de user + sys
+    long max_rss_kb = 0;
+    int failures = 0;
+};
+
+static std::uint64_t now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000ull +
+           static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+// Uma execução; retorna false se não arrancou ou não terminou com 0
+static bool run_once(const Options& opt, Target& t, bool record) {
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    std::string path = t.exe.find('/') == std::string::npos ? "./" + t.exe : t.exe;
+    char* argv[] = {const_cast<char*>(path.c_str()), const_cast<char*>(opt.board), nullptr};
+
+    pid_t pid;
+    std::uint64_t start = now_ns();
+    int rc = posix_spawn(&pid, path.c_str(), &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) {
+        t.failures++;
+        return false;
+    }
+
+    int status = 0;
+    rusage ru{};
+    while (wait4(pid, &status, 0, &ru) < 0) {
+        if (errno != EINTR) {
+            t.failures++;
+            return false;
+        }
+    }
+    std::uint64_t end = now_ns();
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        t.failures++;
+        return false;
+    }
+
+    if (record) {
+        t.wall_ns.push_back(end - start);
+        t.cpu_us += static_cast<std::uint64_t>(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000ull +
+                    static_cast<std::uint64_t>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec);
+        t.max_rss_kb = std::max(t.max_rss_kb, ru.ru_maxrss);
+    }
+    return true;
+}
+
+static void add_glob(const char* pattern, std::vector<std::string>& out) {
+    glob_t g;
+    if (glob(pattern, 0, nullptr, &g) == 0) {
+        for (std::size_t i = 0; i < g.gl_pathc; i++)
+            out.push_back(g.gl_pathv[i]);
+    }
+    globfree(&g);
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+
+        if (std::strncmp(arg, "--", 2) != 0) {
+            opt.exes.push_back(arg);
+        } else if (i + 1 >= argc) {
+            return false;
+        } else if (std::strcmp(arg, "--runs") == 0) {
+            opt.runs = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            opt.warmup = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--board") == 0) {
+            opt.board = argv[++i];
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            opt.csv_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    if (opt.exes.empty()) {
+        add_glob("sudoku_*.exe", opt.exes);
+        add_glob("lean_*.exe", opt.exes);
+    }
+    if (opt.runs < 1)
+        opt.runs = 1;
+    if (opt.warmup < 0)
+        opt.warmup = 0;
+    return true;
+}
+
+static double percentile_us(const std::vector<std::uint64_t>& sorted, double p) {
+    if (sorted.empty())
+        return 0.0;
+    std::size_t i = static_cast<std::size_t>(p * double(sorted.size() - 1) + 0.5);
+    return double(sorted[i]) / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--runs N] [--warmup W] [--board FILE] [--csv FILE|-]\n"
+                     "          [executable...]\n", argv[0]);
+        return 1;
+    }
+    if (opt.exes.empty()) {
+        std::fprintf(stderr, "No executables (build e.g. \"make all lean\" first)\n");
+        return 1;
+    }
+    if (access(opt.board, R_OK) != 0) {
+        std::fprintf(stderr, "Error reading file: %s\n", opt.board);
+        return 1;
+    }
+
+    std::vector<Target> targets;
+    for (const std::string& exe : opt.exes) {
+        Target t;
+        t.exe = exe;
+        t.wall_ns.reserve(static_cast<std::size_t>(opt.runs));
+        targets.push_back(std::move(t));
+    }
+
+    // Aquece a page cache (e o próprio tabuleiro)
+    for (int r = 0; r < opt.warmup; r++) {
+        for (Target& t : targets)
+            run_once(opt, t, false);
+    }
+    for (int r = 0; r < opt.runs; r++) {
+        for (Target& t : targets)
+            run_once(opt, t, true);
+    }
+
+    FILE* csv = nullptr;
+    if (opt.csv_path) {
+        csv = std::strcmp(opt.csv_path, "-") == 0 ? stdout : std::fopen(opt.csv_path, "w");
+        if (!csv) {
+            std::fprintf(stderr, "Cannot write %s\n", opt.csv_path);
+            return 1;
+        }
+        std::fprintf(csv, "program,board,runs,failures,min_us,median_us,p90_us,cpu_us,max_rss_kb\n");
+    }
+    FILE* table = csv == stdout ? stderr : stdout;
+
+    std::fprintf(table, "Board: %s, %d runs per executable (+%d warm-up)\n\n", opt.board,
+                 opt.runs, opt.warmup);
+    std::fprintf(table, "%-32s %10s %10s %10s %10s %8s %6s\n", "program", "min us", "median us",
+                 "p90 us", "cpu us", "rss KB", "fails");
+
+    int rc = 0;
+    for (Target& t : targets) {
+        std::sort(t.wall_ns.begin(), t.wall_ns.end());
+        std::size_t ok = t.wall_ns.size();
+        double min = percentile_us(t.wall_ns, 0.0);
+        double median = percentile_us(t.wall_ns, 0.5);
+        double p90 = percentile_us(t.wall_ns, 0.9);
+        double cpu = ok ? double(t.cpu_us) / double(ok) : 0.0;
+
+        std::fprintf(table, "%-32s %10.1f %10.1f %10.1f %10.1f %8ld %6d\n", t.exe.c_str(), min,
+                     median, p90, cpu, t.max_rss_kb, t.failures);
+        if (csv)
+            std::fprintf(csv, "%s,%s,%zu,%d,%.1f,%.1f,%.1f,%.1f,%ld\n", t.exe.c_str(), opt.board,
+                         ok, t.failures, min, median, p90, cpu, t.max_rss_kb);
+        if (t.failures)
+            rc = 1;
+    }
+
+    if (csv && csv != stdout)
+        std::fclose(csv);
+    return rc;
+}
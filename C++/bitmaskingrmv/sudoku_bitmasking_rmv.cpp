@@ -1,15 +1,14 @@
 #include "sudoku_bitmasking_rmv.hpp"
 #include "../common/board.hpp"
-
-#include <fstream>
-#include <iostream>
+#include "../common/search_trace.hpp"
+#include "../common/cpu_dispatch.hpp"
 
 static constexpr uint16_t FULL_MASK = 0x1FF; // 9 bits ligados (111111111)
 
-// Bitmasks globais de estado
-static uint16_t row_mask[9];
-static uint16_t col_mask[9];
-static uint16_t box_mask[9];
+// Bitmasks de estado (uma cópia por thread)
+static thread_local uint16_t row_mask[9];
+static thread_local uint16_t col_mask[9];
+static thread_local uint16_t box_mask[9];
 
 // --------------------------------------------------
 
@@ -23,8 +22,9 @@ static inline int count_bits(uint16_t x) {
 
 // --------------------------------------------------
 // MRV: escolhe a célula vazia com menos opções
+// (always_inline: compilada dentro de cada versão de solve_recursive)
 
-static bool find_best_cell(const Board& board,
+static inline __attribute__((always_inline)) bool find_best_cell(const Board& board,
                            int& best_r,
                            int& best_c,
                            uint16_t& best_mask,
@@ -62,16 +62,19 @@ static bool find_best_cell(const Board& board,
 }
 
 // --------------------------------------------------
+// Uma versão por nível de CPU (common/cpu_dispatch.hpp)
 
-static bool solve_recursive(Board& board) {
+SUDOKU_DISPATCH static bool solve_recursive(Board& board) {
     int r, c;
     uint16_t avail_mask;
     bool has_empty;
 
     bool ok = find_best_cell(board, r, c, avail_mask, has_empty);
 
-    if (!has_empty)
+    if (!has_empty) {
+        SUDOKU_TRACE_SOLVED();
         return true; // resolvido
+    }
 
     if (!ok)
         return false; // contradição
@@ -89,6 +92,7 @@ static bool solve_recursive(Board& board) {
         row_mask[r] |= bit;
         col_mask[c] |= bit;
         box_mask[b] |= bit;
+        SUDOKU_TRACE_TRY(idx, value, count_bits(avail_mask));
 
         if (solve_recursive(board))
             return true;
@@ -97,6 +101,7 @@ static bool solve_recursive(Board& board) {
         row_mask[r] ^= bit;
         col_mask[c] ^= bit;
         box_mask[b] ^= bit;
+        SUDOKU_TRACE_FAIL(idx, value);
     }
 
     return false;
@@ -105,26 +110,9 @@ static bool solve_recursive(Board& board) {
 // --------------------------------------------------
 // API pública
 
-int read_file(Board& board, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        return 1;
-    }
-
-    int cell_index = 0;
-    char c;
-
-    while (cell_index < 81 && file.get(c)) {
-        if (c >= '0' && c <= '9') {
-            board.cells[cell_index++] = static_cast<uint8_t>(c - '0');
-        }
-    }
-
-    return cell_index == 81 ? 0 : 1;
-}
-
-int solve(const Board& input, Board& solution) {
+int solve_bitmasking(const Board& input, Board& solution) {
     solution = input;
+    SUDOKU_TRACE_BEGIN(TRACE_BITMASKING, input.cells.data());
 
     for (int i = 0; i < 9; i++) {
         row_mask[i] = col_mask[i] = box_mask[i] = 0;
@@ -149,12 +137,3 @@ int solve(const Board& input, Board& solution) {
 
     return solve_recursive(solution) ? 1 : 0;
 }
-
-void print_board(const Board& board) {
-    for (int r = 0; r < 9; r++) {
-        for (int c = 0; c < 9; c++) {
-            std::cout << int(board.cells[r * 9 + c]);
-        }
-        std::cout << "\n";
-    }
-}
@@ -0,0 +1,44 @@
+#include "sudoku_bitmasking_rmv.hpp"
+
+#ifndef SUDOKU_LEAN
+#include <fstream>
+#include <iostream>
+#endif
+
+// Nomes genéricos read_file/solve/print_board de sudoku_bitmasking_rmv.hpp,
+// só para os executáveis com este solver sozinho (sudoku_bitmaskingrmv.exe,
+// batch_*, pipeline_*, server_*, lean_*). Os executáveis com vários solvers
+// não ligam este objeto e chamam solve_bitmasking (ver common/engines.hpp).
+
+int solve(const Board& input, Board& solution) {
+    return solve_bitmasking(input, solution);
+}
+
+#ifndef SUDOKU_LEAN
+int read_file(Board& board, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return 1;
+    }
+
+    int cell_index = 0;
+    char c;
+
+    while (cell_index < 81 && file.get(c)) {
+        if (c >= '0' && c <= '9') {
+            board.cells[cell_index++] = static_cast<uint8_t>(c - '0');
+        }
+    }
+
+    return cell_index == 81 ? 0 : 1;
+}
+
+void print_board(const Board& board) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            std::cout << int(board.cells[r * 9 + c]);
+        }
+        std::cout << "\n";
+    }
+}
+#endif
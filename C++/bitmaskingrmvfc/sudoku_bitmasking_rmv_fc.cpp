@@ -1,21 +1,22 @@
 #include "sudoku_bitmasking_rmv_fc.hpp"
+#include "sudoku_bitmasking_rmv_fc_internal.hpp"
 #include "../common/board.hpp"
+#include "../common/search_trace.hpp"
+#include "../common/cpu_dispatch.hpp"
 
 #include <cstdint>
 #include <vector>
 
-#include <fstream>
 #include <string>
-#include <iostream>
 
 static constexpr uint16_t FULL_MASK = 0x1FF; // 9 bits
 
-static uint16_t row_mask[9];
-static uint16_t col_mask[9];
-static uint16_t box_mask[9];
+static thread_local uint16_t row_mask[9];
+static thread_local uint16_t col_mask[9];
+static thread_local uint16_t box_mask[9];
 
 // Domínios das células (forward checking)
-static uint16_t domain[81];
+static thread_local uint16_t domain[81];
 
 static inline int box_index(int r, int c) {
     return (r / 3) * 3 + (c / 3);
@@ -42,9 +43,14 @@ static void init_domains(const Board& board) {
     }
 }
 
+// --------------------------------------------------
+// As primitivas da procura são sempre inlined em solve_recursive, mesmo
+// com as cópias para os microbenchmarks (fim do ficheiro)
+#define FC_KERNEL static inline __attribute__((always_inline))
+
 // --------------------------------------------------
 // MRV com domínios
-static bool find_best_cell(int& best_idx) {
+FC_KERNEL bool find_best_cell(int& best_idx) {
     int min_count = 10;
     best_idx = -1;
 
@@ -68,12 +74,9 @@ static bool find_best_cell(int& best_idx) {
 // --------------------------------------------------
 // Forward checking: remove valor dos vizinhos
 
-struct Change {
-    int idx;
-    uint16_t old_domain;
-};
+using Change = FcChange;
 
-static bool propagate(int idx, uint16_t bit, std::vector<Change>& changes) {
+FC_KERNEL bool propagate(int idx, uint16_t bit, std::vector<Change>& changes) {
     int r = idx / 9;
     int c = idx % 9;
     int b = box_index(r, c);
@@ -115,18 +118,22 @@ static bool propagate(int idx, uint16_t bit, std::vector<Change>& changes) {
     return true;
 }
 
-static void undo(const std::vector<Change>& changes) {
+FC_KERNEL void undo(const std::vector<Change>& changes) {
     for (auto it = changes.rbegin(); it != changes.rend(); ++it) {
         domain[it->idx] = it->old_domain;
     }
 }
 
 // --------------------------------------------------
+// Uma versão por nível de CPU (common/cpu_dispatch.hpp); as primitivas
+// FC_KERNEL são compiladas dentro de cada uma
 
-static bool solve_recursive(Board& board) {
+SUDOKU_DISPATCH static bool solve_recursive(Board& board) {
     int idx;
-    if (!find_best_cell(idx))
+    if (!find_best_cell(idx)) {
+        SUDOKU_TRACE_SOLVED();
         return true; // resolvido
+    }
 
     uint16_t avail = domain[idx];
     int r = idx / 9;
@@ -143,6 +150,7 @@ static bool solve_recursive(Board& board) {
         row_mask[r] |= bit;
         col_mask[c] |= bit;
         box_mask[b] |= bit;
+        SUDOKU_TRACE_TRY(idx, value, __builtin_popcount(avail));
 
         std::vector<Change> changes;
         uint16_t old_domain = domain[idx];
@@ -161,6 +169,7 @@ static bool solve_recursive(Board& board) {
 
         domain[idx] = old_domain;
         undo(changes);
+        SUDOKU_TRACE_FAIL(idx, value);
     }
 
     return false;
@@ -168,16 +177,15 @@ static bool solve_recursive(Board& board) {
 
 // --------------------------------------------------
 
-int solve(const Board& input, Board& solution) {
-    solution = input;
-
+// Máscaras e domínios a partir das células preenchidas
+static void load_state(const Board& board) {
     for (int i = 0; i < 9; i++)
         row_mask[i] = col_mask[i] = box_mask[i] = 0;
 
     for (int r = 0; r < 9; r++) {
         for (int c = 0; c < 9; c++) {
             int idx = r * 9 + c;
-            int v = solution.cells[idx];
+            int v = board.cells[idx];
             if (v != 0) {
                 uint16_t bit = 1 << (v - 1);
                 int b = box_index(r, c);
@@ -188,34 +196,42 @@ int solve(const Board& input, Board& solution) {
         }
     }
 
-    init_domains(solution);
+    init_domains(board);
+}
+
+int solve_bitmasking_fc(const Board& input, Board& solution) {
+    solution = input;
+    SUDOKU_TRACE_BEGIN(TRACE_BITMASKING_FC, input.cells.data());
+
+    load_state(solution);
 
     return solve_recursive(solution) ? 1 : 0;
 }
 
-int read_file(Board& board, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        return 1;
-    }
+// --------------------------------------------------
+// Primitivas para os microbenchmarks (sudoku_bitmasking_rmv_fc_internal.hpp),
+// com o mesmo despacho que solve_recursive
 
-    int cell_index = 0;
-    char c;
+namespace fc_internal {
 
-    while (cell_index < 81 && file.get(c)) {
-        if (c >= '0' && c <= '9') {
-            board.cells[cell_index++] = static_cast<uint8_t>(c - '0');
-        }
-    }
+void load(const Board& board) {
+    load_state(board);
+}
 
-    return cell_index == 81 ? 0 : 1;
+uint16_t* domains() {
+    return domain;
 }
 
-void print_board(const Board& board) {
-    for (int r = 0; r < 9; r++) {
-        for (int c = 0; c < 9; c++) {
-            std::cout << int(board.cells[r * 9 + c]);
-        }
-        std::cout << "\n";
-    }
+SUDOKU_DISPATCH bool find_best_cell(int& best_idx) {
+    return ::find_best_cell(best_idx);
+}
+
+SUDOKU_DISPATCH bool propagate(int idx, uint16_t bit, std::vector<Change>& changes) {
+    return ::propagate(idx, bit, changes);
 }
+
+SUDOKU_DISPATCH void undo(const std::vector<Change>& changes) {
+    ::undo(changes);
+}
+
+} // namespace fc_internal
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../common/board.hpp"
+
+/*
+ * Primitivas internas do solver FC, expostas só para os microbenchmarks
+ * (microbench.cpp). Não fazem parte da API: trabalham sobre o estado
+ * thread_local do solver, tal como solve_recursive.
+ */
+// Entrada do registo de alterações do forward checking
+struct FcChange {
+    int idx;
+    uint16_t old_domain;
+};
+
+namespace fc_internal {
+
+/*
+ * Carrega máscaras e domínios a partir de um tabuleiro, possivelmente
+ * parcial (igual ao estado da procura com essas células colocadas).
+ */
+void load(const Board& board);
+
+// Domínios das 81 células (0 = célula preenchida)
+uint16_t* domains();
+
+// MRV: célula com menos candidatos; false se não há células vazias
+bool find_best_cell(int& best_idx);
+
+// Remove "bit" dos vizinhos de idx; false se algum domínio fica vazio
+bool propagate(int idx, uint16_t bit, std::vector<FcChange>& changes);
+
+// Repõe os domínios alterados por propagate
+void undo(const std::vector<FcChange>& changes);
+
+} // namespace fc_internal
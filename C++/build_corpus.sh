@@ -0,0 +1,21 @@
+#!/bin/bash
+# Builds the benchmark corpus in corpus/: one file per tier, one board per line.
+# The seeds are fixed, so the same count always gives the same files.
+#
+#   ./build_corpus.sh [count] [seed]      (default: 10000 puzzles per tier, seed 1)
+#   ./benchmark_corpus.exe                (puzzles/s per engine and tier)
+
+set -e
+
+COUNT=${1:-10000}
+SEED=${2:-1}
+OUT_DIR=${OUT_DIR:-corpus}
+
+cd "$(dirname "$0")"
+make -s generate_corpus benchmark_corpus
+
+mkdir -p "$OUT_DIR"
+for tier in easy minimal hard; do
+  echo "[INFO] Generating ${COUNT} ${tier} puzzles (seed ${SEED})"
+  ./generate_corpus.exe --tier "$tier" --count "$COUNT" --seed "$SEED" "$OUT_DIR/$tier.txt"
+done
@@ -0,0 +1,49 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+double percentile_sorted(const std::vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+
+    double pos = p / 100.0 * double(sorted.size() - 1);
+    std::size_t lo = static_cast<std::size_t>(pos);
+    std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double frac = pos - double(lo);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac;
+}
+
+SampleStats compute_stats(std::vector<double> values) {
+    SampleStats s;
+    s.samples = values.size();
+    if (values.empty())
+        return s;
+
+    std::sort(values.begin(), values.end());
+
+    double sum = 0;
+    for (double v : values)
+        sum += v;
+    s.mean = sum / double(values.size());
+
+    double sq = 0;
+    for (double v : values)
+        sq += (v - s.mean) * (v - s.mean);
+    s.stddev = values.size() > 1 ? std::sqrt(sq / double(values.size() - 1)) : 0;
+
+    s.min = values.front();
+    s.max = values.back();
+    s.median = percentile_sorted(values, 50);
+    s.p90 = percentile_sorted(values, 90);
+    s.p99 = percentile_sorted(values, 99);
+
+    double q1 = percentile_sorted(values, 25);
+    double q3 = percentile_sorted(values, 75);
+    double fence = 1.5 * (q3 - q1);
+    for (double v : values) {
+        if (v < q1 - fence || v > q3 + fence)
+            s.outliers++;
+    }
+    return s;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * Utilitários para benchmarks dentro do processo.
+ */
+
+/*
+ * Barreiras para o compilador (como o DoNotOptimize/ClobberMemory do
+ * Google Benchmark): do_not_optimize obriga "value" a existir em registo
+ * ou memória nesse ponto, por isso o cálculo não pode ser eliminado nem
+ * tirado do loop; clobber_memory obriga a escrever tudo em memória.
+ */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void do_not_optimize(T& value) {
+    asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+/*
+ * Estatísticas de um conjunto de amostras (p.ex. ns por iteração).
+ * Percentis com interpolação linear; "outliers" conta as amostras fora de
+ * [Q1 - 1.5 IQR, Q3 + 1.5 IQR] (não são removidas: a mediana já é robusta).
+ */
+struct SampleStats {
+    std::size_t samples = 0;
+    double min = 0;
+    double median = 0;
+    double mean = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+    double stddev = 0;
+    std::size_t outliers = 0;
+};
+
+SampleStats compute_stats(std::vector<double> values);
+
+/*
+ * Percentil "p" (0-100) de um vetor já ordenado.
+ */
+double percentile_sorted(const std::vector<double>& sorted, double p);
@@ -0,0 +1,376 @@
+#include "board_dir.hpp"
+#include "board_parse.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Listagem
+
+static bool has_board_suffix(const char* name) {
+    static const char suffix[] = ".sudoku";
+    std::size_t len = std::strlen(name);
+    std::size_t suf = sizeof(suffix) - 1;
+    return len > suf && std::strcmp(name + len - suf, suffix) == 0;
+}
+
+int list_board_files(const std::string& dir, std::vector<std::string>& paths) {
+    DIR* d = opendir(dir.c_str());
+    if (!d)
+        return 1;
+
+    std::string prefix = dir;
+    if (!prefix.empty() && prefix.back() != '/')
+        prefix += '/';
+
+    paths.clear();
+    while (dirent* e = readdir(d)) {
+        if (e->d_type != DT_REG && e->d_type != DT_UNKNOWN)
+            continue;
+        if (has_board_suffix(e->d_name))
+            paths.push_back(prefix + e->d_name);
+    }
+    closedir(d);
+
+    std::sort(paths.begin(), paths.end());
+    return 0;
+}
+
+// --------------------------------------------------
+// io_uring com syscalls diretos (sem liburing)
+
+static int sys_io_uring_setup(unsigned entries, io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, const void* arg, unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// Um anel mínimo: só o que o loader precisa (sem SQPOLL, uma thread).
+class Uring {
+public:
+    Uring() = default;
+    Uring(const Uring&) = delete;
+    Uring& operator=(const Uring&) = delete;
+
+    ~Uring() {
+        if (sqes_)
+            munmap(sqes_, sqes_size_);
+        if (cq_ptr_ && cq_ptr_ != sq_ptr_)
+            munmap(cq_ptr_, cq_size_);
+        if (sq_ptr_)
+            munmap(sq_ptr_, sq_size_);
+        if (fd_ >= 0)
+            close(fd_);
+    }
+
+    int init(unsigned entries) {
+        io_uring_params p{};
+        fd_ = sys_io_uring_setup(entries, &p);
+        if (fd_ < 0)
+            return 1;
+
+        sq_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+        sq_ptr_ = map(sq_size_, IORING_OFF_SQ_RING);
+        if (!sq_ptr_)
+            return 1;
+        cq_ptr_ = single ? sq_ptr_ : map(cq_size_, IORING_OFF_CQ_RING);
+        if (!cq_ptr_)
+            return 1;
+
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (!sqes_)
+            return 1;
+
+        char* sq = static_cast<char*>(sq_ptr_);
+        char* cq = static_cast<char*>(cq_ptr_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_entries_ = p.sq_entries;
+        cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+        // Índice i do array -> SQE i (fixo)
+        unsigned* array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        for (unsigned i = 0; i < p.sq_entries; i++)
+            array[i] = i;
+
+        sqe_tail_ = *sq_tail_;
+        return 0;
+    }
+
+    // Tabela de ficheiros fixos vazia: o openat escreve diretamente num slot
+    int register_sparse_files(unsigned count) {
+        std::vector<int> fds(count, -1);
+        return sys_io_uring_register(fd_, IORING_REGISTER_FILES, fds.data(), count) < 0 ? 1 : 0;
+    }
+
+    io_uring_sqe* get_sqe() {
+        unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sqe_tail_ - head >= sq_entries_)
+            return nullptr;
+
+        io_uring_sqe* sqe = &sqes_[sqe_tail_ & sq_mask_];
+        sqe_tail_++;
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    // Submete os SQEs preparados e espera por pelo menos "wait_nr" CQEs
+    int submit_and_wait(unsigned wait_nr) {
+        unsigned to_submit = sqe_tail_ - *sq_tail_;
+        __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+
+        for (;;) {
+            int ret = sys_io_uring_enter(fd_, to_submit, wait_nr, IORING_ENTER_GETEVENTS);
+            if (ret >= 0 || errno != EINTR)
+                return ret < 0 ? 1 : 0;
+            to_submit = 0; // já consumidos antes da interrupção
+        }
+    }
+
+    template <typename Fn>
+    void for_each_cqe(Fn fn) {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++)
+            fn(cqes_[head & cq_mask_]);
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+
+private:
+    void* map(std::size_t size, off_t offset) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    int fd_ = -1;
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    std::size_t sq_size_ = 0;
+    std::size_t cq_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned sqe_tail_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+// Ficheiros abertos ao mesmo tempo (= slots na tabela de ficheiros fixos)
+static constexpr unsigned URING_FILES_IN_FLIGHT = 128;
+
+enum UringOp : std::uint64_t { OP_OPEN = 0, OP_READ = 1, OP_CLOSE = 2 };
+
+struct UringSlot {
+    std::size_t file = 0;
+    int pending = 0; // CQEs que faltam (open, read, close)
+    int bytes = -1;
+    char buf[BOARD_FILE_READ_SIZE];
+};
+
+bool io_uring_available() {
+    Uring ring;
+    return ring.init(4) == 0 && ring.register_sparse_files(1) == 0;
+}
+
+// Cada ficheiro é uma cadeia openat -> read -> close num slot fixo, por isso
+// não é preciso esperar pelo fd do openat para submeter o read.
+static long load_with_uring(const std::vector<std::string>& paths, std::vector<Board>& boards,
+                            std::vector<std::uint8_t>& ok) {
+    const std::size_t n = paths.size();
+    if (n == 0)
+        return 0;
+
+    Uring ring;
+    unsigned slots = static_cast<unsigned>(std::min<std::size_t>(URING_FILES_IN_FLIGHT, n));
+    if (ring.init(4 * URING_FILES_IN_FLIGHT) != 0 || ring.register_sparse_files(slots) != 0)
+        return -1;
+
+    std::vector<UringSlot> state(slots);
+    std::vector<unsigned> free_slots;
+    for (unsigned s = slots; s > 0; s--)
+        free_slots.push_back(s - 1);
+
+    std::size_t next_file = 0;
+    std::size_t in_flight = 0;
+    long loaded = 0;
+    bool unsupported = false;
+
+    while (next_file < n || in_flight > 0) {
+        while (next_file < n && !free_slots.empty()) {
+            unsigned s = free_slots.back();
+            free_slots.pop_back();
+
+            UringSlot& slot = state[s];
+            slot.file = next_file++;
+            slot.pending = 3;
+            slot.bytes = -1;
+
+            // O anel tem 4 SQEs por slot e é esvaziado a cada submit: nunca falta lugar
+            io_uring_sqe* open_sqe = ring.get_sqe();
+            io_uring_sqe* read_sqe = ring.get_sqe();
+            io_uring_sqe* close_sqe = ring.get_sqe();
+
+            open_sqe->opcode = IORING_OP_OPENAT;
+            open_sqe->fd = AT_FDCWD;
+            open_sqe->addr = reinterpret_cast<std::uint64_t>(paths[slot.file].c_str());
+            open_sqe->open_flags = O_RDONLY; // O_CLOEXEC não é aceite com file_index
+            open_sqe->file_index = s + 1;
+            open_sqe->flags = IOSQE_IO_LINK;
+            open_sqe->user_data = (std::uint64_t(s) << 2) | OP_OPEN;
+
+            // HARDLINK: um read curto (o normal aqui) não pode cancelar o close
+            read_sqe->opcode = IORING_OP_READ;
+            read_sqe->fd = static_cast<int>(s);
+            read_sqe->addr = reinterpret_cast<std::uint64_t>(slot.buf);
+            read_sqe->len = sizeof(slot.buf);
+            read_sqe->off = 0;
+            read_sqe->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+            read_sqe->user_data = (std::uint64_t(s) << 2) | OP_READ;
+
+            close_sqe->opcode = IORING_OP_CLOSE;
+            close_sqe->file_index = s + 1;
+            close_sqe->user_data = (std::uint64_t(s) << 2) | OP_CLOSE;
+
+            in_flight++;
+        }
+
+        if (ring.submit_and_wait(1) != 0)
+            return -1;
+
+        ring.for_each_cqe([&](const io_uring_cqe& cqe) {
+            unsigned s = static_cast<unsigned>(cqe.user_data >> 2);
+            UringSlot& slot = state[s];
+
+            switch (cqe.user_data & 3) {
+            case OP_OPEN:
+                // Kernel sem openat para ficheiros fixos (< 5.15)
+                if (cqe.res == -EINVAL)
+                    unsupported = true;
+                break;
+            case OP_READ:
+                slot.bytes = cqe.res;
+                break;
+            default:
+                break;
+            }
+
+            if (--slot.pending > 0)
+                return;
+
+            if (slot.bytes > 0 &&
+                parse_board_file(slot.buf, static_cast<std::size_t>(slot.bytes), boards[slot.file]) == 0) {
+                ok[slot.file] = 1;
+                loaded++;
+            } else {
+                boards[slot.file] = Board{};
+            }
+
+            free_slots.push_back(s);
+            in_flight--;
+        });
+    }
+
+    return unsupported ? -1 : loaded;
+}
+
+// --------------------------------------------------
+// Fallback: pool de threads, cada uma com open/pread/close
+
+static constexpr std::size_t THREAD_CHUNK = 64;
+
+static long load_with_threads(const std::vector<std::string>& paths, std::vector<Board>& boards,
+                              std::vector<std::uint8_t>& ok, unsigned threads) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    const std::size_t n = paths.size();
+    std::atomic<std::size_t> next{0};
+    std::atomic<long> loaded{0};
+
+    auto worker = [&] {
+        char buf[BOARD_FILE_READ_SIZE];
+        long local = 0;
+
+        for (;;) {
+            std::size_t begin = next.fetch_add(THREAD_CHUNK, std::memory_order_relaxed);
+            if (begin >= n)
+                break;
+            std::size_t end = std::min(n, begin + THREAD_CHUNK);
+
+            for (std::size_t i = begin; i < end; i++) {
+                ssize_t bytes = -1;
+                int fd = open(paths[i].c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd >= 0) {
+                    bytes = pread(fd, buf, sizeof(buf), 0);
+                    close(fd);
+                }
+
+                if (bytes > 0 && parse_board_file(buf, static_cast<std::size_t>(bytes), boards[i]) == 0) {
+                    ok[i] = 1;
+                    local++;
+                } else {
+                    boards[i] = Board{};
+                }
+            }
+        }
+        loaded.fetch_add(local, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool)
+        t.join();
+
+    return loaded.load();
+}
+
+long load_board_files(const std::vector<std::string>& paths, std::vector<Board>& boards,
+                      std::vector<std::uint8_t>& ok, DirLoadMethod method, unsigned threads) {
+    boards.assign(paths.size(), Board{});
+    ok.assign(paths.size(), 0);
+
+    if (method != DirLoadMethod::THREADS) {
+        long loaded = load_with_uring(paths, boards, ok);
+        if (loaded >= 0 || method == DirLoadMethod::IO_URING)
+            return loaded;
+
+        // io_uring indisponível: recomeça com as threads
+        ok.assign(paths.size(), 0);
+    }
+
+    return load_with_threads(paths, boards, ok, threads);
+}
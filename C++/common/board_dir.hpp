@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "board.hpp"
+
+/*
+ * Carregamento de diretórios com muitos ficheiros pequenos de 9 linhas
+ * (como os de boards/). Com um ficheiro por tabuleiro o custo é quase só
+ * de syscalls, por isso há duas alternativas ao open/read/close sequencial:
+ *   - io_uring: open/read/close de muitos ficheiros numa só submissão;
+ *   - pool de threads com pread (quando o io_uring não está disponível).
+ */
+
+enum class DirLoadMethod {
+    AUTO,     // io_uring, ou threads se falhar
+    IO_URING,
+    THREADS
+};
+
+/*
+ * Lista os ficheiros "*.sudoku" de "dir" (caminhos completos, ordenados).
+ * Retorna 0 em sucesso, 1 se o diretório não puder ser lido.
+ */
+int list_board_files(const std::string& dir, std::vector<std::string>& paths);
+
+/*
+ * Lê os ficheiros "paths" para "boards" (mesma ordem).
+ * "ok[i]" fica a 1 se o ficheiro i foi lido e é válido (mesmas regras
+ * que read_file_raw); caso contrário boards[i] fica vazio.
+ * "threads" só é usado pelo método THREADS (0 = um por core).
+ * Retorna o número de ficheiros lidos com sucesso, ou -1 se o método
+ * pedido não estiver disponível (p.ex. io_uring bloqueado pelo seccomp).
+ */
+long load_board_files(const std::vector<std::string>& paths, std::vector<Board>& boards,
+                      std::vector<std::uint8_t>& ok, DirLoadMethod method = DirLoadMethod::AUTO,
+                      unsigned threads = 0);
+
+/*
+ * true se o kernel aceita io_uring com open/read/close em ficheiros fixos.
+ */
+bool io_uring_available();
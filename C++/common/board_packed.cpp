@@ -0,0 +1,177 @@
+#include "board_packed.hpp"
+#include "board_parse.hpp"
+#include "cpu_dispatch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// --------------------------------------------------
+// Scalar
+
+void pack_board_scalar(const Board& board, PackedBoard& packed) {
+    const std::uint8_t* cells = board.cells.data();
+
+    for (int i = 0; i < 40; i++)
+        packed.bytes[i] = static_cast<std::uint8_t>(cells[2 * i] | (cells[2 * i + 1] << 4));
+    packed.bytes[40] = cells[80];
+}
+
+int unpack_board_scalar(const PackedBoard& packed, Board& board) {
+    std::uint8_t* cells = board.cells.data();
+    std::uint8_t max = 0;
+
+    for (int i = 0; i < 40; i++) {
+        cells[2 * i] = packed.bytes[i] & 0x0F;
+        cells[2 * i + 1] = packed.bytes[i] >> 4;
+        max = std::max(max, std::max(cells[2 * i], cells[2 * i + 1]));
+    }
+    cells[80] = packed.bytes[40] & 0x0F;
+    max = std::max(max, cells[80]);
+
+    return max > 9 ? 1 : 0;
+}
+
+// --------------------------------------------------
+// SIMD: 16 células <-> 8 bytes por iteração.
+// pack precisa de SSSE3 (pmaddubsw) e é escolhido em tempo de execução;
+// unpack só usa SSE2, que todo o x86-64 tem.
+
+#if defined(__x86_64__)
+
+SUDOKU_TARGET("ssse3")
+static void pack_board_ssse3(const Board& board, PackedBoard& packed) {
+    const std::uint8_t* cells = board.cells.data();
+    // par de bytes (a, b) -> a * 1 + b * 16
+    const __m128i weights = _mm_set1_epi16(0x1001);
+
+    for (int i = 0; i < 5; i++) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + 16 * i));
+        __m128i pairs = _mm_maddubs_epi16(v, weights);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(packed.bytes.data() + 8 * i),
+                         _mm_packus_epi16(pairs, pairs));
+    }
+    packed.bytes[40] = cells[80];
+}
+
+using PackFn = void (*)(const Board&, PackedBoard&);
+
+extern "C" {
+static PackFn resolve_pack_board() {
+    return cpu_has_ssse3() ? pack_board_ssse3 : pack_board_scalar;
+}
+}
+
+void pack_board(const Board& board, PackedBoard& packed) __attribute__((ifunc("resolve_pack_board")));
+
+#else
+
+void pack_board(const Board& board, PackedBoard& packed) {
+    pack_board_scalar(board, packed);
+}
+
+#endif
+
+int unpack_board(const PackedBoard& packed, Board& board) {
+#if defined(__SSE2__)
+    std::uint8_t* cells = board.cells.data();
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    __m128i max = _mm_setzero_si128();
+
+    for (int i = 0; i < 5; i++) {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(packed.bytes.data() + 8 * i));
+        __m128i lo = _mm_and_si128(v, low_nibble);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble);
+        __m128i out = _mm_unpacklo_epi8(lo, hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cells + 16 * i), out);
+        max = _mm_max_epu8(max, out);
+    }
+    cells[80] = packed.bytes[40] & 0x0F;
+
+    // max(m, 9) == 9 em todos os bytes se nenhuma célula passar de 9
+    int in_range = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(max, nine), nine));
+    return (in_range != 0xFFFF || cells[80] > 9) ? 1 : 0;
+#else
+    return unpack_board_scalar(packed, board);
+#endif
+}
+
+// --------------------------------------------------
+// Cabeçalho
+
+PackedHeader make_packed_header(std::uint64_t count) {
+    PackedHeader h;
+    std::memcpy(h.magic, PACKED_MAGIC, sizeof(h.magic));
+    h.version = PACKED_VERSION;
+    h.board_size = static_cast<std::uint16_t>(PACKED_BOARD_SIZE);
+    h.count = count;
+    return h;
+}
+
+bool is_packed_data(const char* data, std::size_t size) {
+    if (size < sizeof(PackedHeader))
+        return false;
+
+    PackedHeader h;
+    std::memcpy(&h, data, sizeof(h));
+    return std::memcmp(h.magic, PACKED_MAGIC, sizeof(h.magic)) == 0 &&
+           h.version == PACKED_VERSION &&
+           h.board_size == PACKED_BOARD_SIZE;
+}
+
+// --------------------------------------------------
+// Loader
+
+static int unpack_boards(const char* data, std::size_t size, std::vector<Board>& boards) {
+    PackedHeader h;
+    std::memcpy(&h, data, sizeof(h));
+
+    std::size_t payload = size - sizeof(PackedHeader);
+    if (payload % PACKED_BOARD_SIZE != 0)
+        return 1;
+
+    std::size_t count = payload / PACKED_BOARD_SIZE;
+    if (h.count != 0 && h.count != count)
+        return 1;
+
+    const char* p = data + sizeof(PackedHeader);
+    std::size_t first = boards.size();
+    boards.resize(first + count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        PackedBoard pb;
+        std::memcpy(pb.bytes.data(), p + i * PACKED_BOARD_SIZE, PACKED_BOARD_SIZE);
+        if (unpack_board(pb, boards[first + i]) != 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+int load_boards(const std::string& filename, std::vector<Board>& boards) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    std::vector<char> buf;
+    std::size_t size;
+    int err = read_fd_fully(fd, buf, size);
+    close(fd);
+
+    if (err)
+        return 1;
+
+    if (is_packed_data(buf.data(), size))
+        return unpack_boards(buf.data(), size, boards);
+
+    return parse_board_lines(buf.data(), size, boards);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "board.hpp"
+
+/*
+ * Formato binário compacto: 4 bits por célula, 41 bytes por tabuleiro.
+ * A célula 2i fica no nibble baixo do byte i e a célula 2i+1 no nibble alto
+ * (a célula 80 ocupa sozinha o byte 40).
+ */
+static constexpr std::size_t PACKED_BOARD_SIZE = 41;
+
+struct PackedBoard {
+    std::array<std::uint8_t, PACKED_BOARD_SIZE> bytes{};
+};
+
+/*
+ * Cabeçalho do ficheiro (16 bytes, little-endian).
+ * "count" a 0 significa "até ao fim do ficheiro" (ex.: escrito para um pipe).
+ */
+static constexpr char PACKED_MAGIC[4] = {'S', 'D', 'K', 'P'};
+static constexpr std::uint16_t PACKED_VERSION = 1;
+
+struct PackedHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t board_size;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(PackedHeader) == 16, "PackedHeader must be 16 bytes");
+
+void pack_board(const Board& board, PackedBoard& packed);
+
+/*
+ * Desempacota para "board". Retorna 0 em sucesso, 1 se algum nibble for
+ * maior que 9 (não é um valor de célula, como um carácter inválido numa
+ * linha de texto); nesse caso o conteúdo de "board" não deve ser usado.
+ */
+int unpack_board(const PackedBoard& packed, Board& board);
+
+/*
+ * Versões sem SIMD (referência).
+ */
+void pack_board_scalar(const Board& board, PackedBoard& packed);
+int unpack_board_scalar(const PackedBoard& packed, Board& board);
+
+PackedHeader make_packed_header(std::uint64_t count);
+
+/*
+ * Verifica se "data" começa com um cabeçalho válido.
+ */
+bool is_packed_data(const char* data, std::size_t size);
+
+/*
+ * Lê um ficheiro em qualquer um dos formatos (linhas de 81 caracteres
+ * ou binário compacto, detetado pelo cabeçalho).
+ * Retorna 0 em sucesso, 1 em erro.
+ */
+int load_boards(const std::string& filename, std::vector<Board>& boards);
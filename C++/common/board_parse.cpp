@@ -0,0 +1,325 @@
+#include "board_parse.hpp"
+#include "cpu_dispatch.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// --------------------------------------------------
+// Fim de linha: depois das 81 células tem de vir '\n', "\r\n"
+// ou o fim dos dados.
+
+static inline int line_end(const char* line, std::size_t avail) {
+    if (avail == 81)
+        return 81;
+    if (line[81] == '\n')
+        return 82;
+    if (line[81] == '\r' && avail > 82 && line[82] == '\n')
+        return 83;
+    return -1;
+}
+
+// --------------------------------------------------
+// Scalar
+
+int parse_board_line_scalar(const char* line, std::size_t avail, Board& board) {
+    if (avail < 81)
+        return -1;
+
+    std::uint8_t cells[81];
+
+    for (int i = 0; i < 81; i++) {
+        char c = line[i];
+        if (c >= '0' && c <= '9')
+            cells[i] = static_cast<std::uint8_t>(c - '0');
+        else if (c == '.')
+            cells[i] = 0;
+        else
+            return -1;
+    }
+
+    int used = line_end(line, avail);
+    if (used < 0)
+        return -1;
+
+    std::memcpy(board.cells.data(), cells, 81);
+    return used;
+}
+
+#if defined(__x86_64__)
+
+// --------------------------------------------------
+// AVX2: 3 registos de 32 bytes cobrem as 81 células e o '\n'.
+// d = c - '0' é um dígito se min(d, 9) == d (comparação sem sinal).
+
+SUDOKU_TARGET("avx2") static inline __m256i digits_avx2(__m256i c, __m256i& ok) {
+    const __m256i zero_ch = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i dot = _mm256_set1_epi8('.');
+
+    __m256i d = _mm256_sub_epi8(c, zero_ch);
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(d, nine), d);
+    __m256i is_dot = _mm256_cmpeq_epi8(c, dot);
+
+    ok = _mm256_or_si256(is_digit, is_dot);
+    return _mm256_and_si256(d, is_digit); // '.' -> 0
+}
+
+SUDOKU_TARGET("avx2")
+static int parse_board_line_avx2(const char* line, std::size_t avail, Board& board) {
+    if (avail < 81)
+        return -1;
+
+    __m256i c0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line));
+    __m256i c1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line + 32));
+    __m256i c2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(line + 64));
+
+    __m256i ok0, ok1, ok2;
+    __m256i d0 = digits_avx2(c0, ok0);
+    __m256i d1 = digits_avx2(c1, ok1);
+    __m256i d2 = digits_avx2(c2, ok2);
+
+    // Células 64..80 são os bits 0..16 do terceiro registo
+    std::uint32_t m0 = static_cast<std::uint32_t>(_mm256_movemask_epi8(ok0));
+    std::uint32_t m1 = static_cast<std::uint32_t>(_mm256_movemask_epi8(ok1));
+    std::uint32_t m2 = static_cast<std::uint32_t>(_mm256_movemask_epi8(ok2));
+    if ((m0 & m1) != 0xFFFFFFFFu || (m2 & 0x1FFFFu) != 0x1FFFFu)
+        return -1;
+
+    int used = 81;
+    if (avail > 81) {
+        // Primeiro '\n' depois da célula 80 (bytes 81..95)
+        std::uint32_t nl = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(c2, _mm256_set1_epi8('\n')))) >> 17;
+        if (nl & 1u)
+            used = 82;
+        else if ((nl & 2u) && line[81] == '\r' && avail > 82)
+            used = 83;
+        else
+            return -1;
+    }
+
+    std::uint8_t* out = board.cells.data();
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), d0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), d1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 64), _mm256_castsi256_si128(d2));
+    out[80] = static_cast<std::uint8_t>(_mm256_extract_epi8(d2, 16));
+
+    return used;
+}
+
+// --------------------------------------------------
+// SSE4.1: 6 registos de 16 bytes.
+
+SUDOKU_TARGET("sse4.1") static inline __m128i digits_sse(__m128i c, __m128i& ok) {
+    const __m128i zero_ch = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i dot = _mm_set1_epi8('.');
+
+    __m128i d = _mm_sub_epi8(c, zero_ch);
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+    __m128i is_dot = _mm_cmpeq_epi8(c, dot);
+
+    ok = _mm_or_si128(is_digit, is_dot);
+    return _mm_and_si128(d, is_digit);
+}
+
+SUDOKU_TARGET("sse4.1")
+static int parse_board_line_sse41(const char* line, std::size_t avail, Board& board) {
+    if (avail < 81)
+        return -1;
+
+    __m128i d[6];
+    std::uint32_t all = 0xFFFFu;
+    __m128i last = _mm_setzero_si128();
+
+    for (int i = 0; i < 6; i++) {
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + 16 * i));
+        __m128i ok;
+        d[i] = digits_sse(c, ok);
+
+        std::uint32_t m = static_cast<std::uint32_t>(_mm_movemask_epi8(ok));
+        all &= (i < 5) ? m : (m | 0xFFFEu); // só a célula 80 conta no último
+        last = c;
+    }
+
+    if (all != 0xFFFFu)
+        return -1;
+
+    int used = 81;
+    if (avail > 81) {
+        // bytes 81..95 estão no último registo (posições 1..15)
+        std::uint32_t nl = static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(last, _mm_set1_epi8('\n')))) >> 1;
+        if (nl & 1u)
+            used = 82;
+        else if ((nl & 2u) && line[81] == '\r' && avail > 82)
+            used = 83;
+        else
+            return -1;
+    }
+
+    std::uint8_t* out = board.cells.data();
+    for (int i = 0; i < 5; i++)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), d[i]);
+    out[80] = static_cast<std::uint8_t>(_mm_extract_epi8(d[5], 0));
+
+    return used;
+}
+
+#endif
+
+// --------------------------------------------------
+// Escolha em tempo de execução: o resolver (ifunc) corre uma vez, ao
+// carregar o executável (common/cpu_dispatch.hpp)
+
+using ParseLineFn = int (*)(const char*, std::size_t, Board&);
+
+static ParseLineFn choose_parse_board_line() {
+#if defined(__x86_64__)
+    if (cpu_has_avx2())
+        return parse_board_line_avx2;
+    if (cpu_has_sse41())
+        return parse_board_line_sse41;
+#endif
+    return parse_board_line_scalar;
+}
+
+#if defined(__x86_64__)
+extern "C" {
+static ParseLineFn resolve_parse_board_line() {
+    return choose_parse_board_line();
+}
+}
+
+int parse_board_line(const char* line, std::size_t avail, Board& board)
+    __attribute__((ifunc("resolve_parse_board_line")));
+#else
+int parse_board_line(const char* line, std::size_t avail, Board& board) {
+    return parse_board_line_scalar(line, avail, board);
+}
+#endif
+
+const char* parse_board_impl() {
+    ParseLineFn fn = choose_parse_board_line();
+#if defined(__x86_64__)
+    if (fn == parse_board_line_avx2)
+        return "avx2";
+    if (fn == parse_board_line_sse41)
+        return "sse4.1";
+#endif
+    (void)fn;
+    return "scalar";
+}
+
+// --------------------------------------------------
+// Bulk loader
+
+int read_fd_fully(int fd, std::vector<char>& buf, std::size_t& size) {
+    // o tamanho do ficheiro é só uma dica: pipes e /dev/stdin têm st_size 0
+    struct stat st;
+    std::size_t hint = 1 << 16;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+        hint = static_cast<std::size_t>(st.st_size) + 1;
+
+    buf.resize(hint + PARSE_WINDOW);
+    size = 0;
+
+    for (;;) {
+        if (size + PARSE_WINDOW == buf.size())
+            buf.resize(buf.size() * 2);
+
+        ssize_t n = read(fd, buf.data() + size, buf.size() - PARSE_WINDOW - size);
+        if (n < 0)
+            return 1;
+        if (n == 0)
+            break;
+        size += static_cast<std::size_t>(n);
+    }
+
+    // padding para o parser poder ler sempre 96 bytes
+    std::memset(buf.data() + size, 0, PARSE_WINDOW);
+    return 0;
+}
+
+int parse_board_lines(const char* data, std::size_t size, std::vector<Board>& boards) {
+    boards.reserve(boards.size() + size / 82 + 1);
+
+    std::size_t pos = 0;
+    while (pos < size) {
+        const char* p = data + pos;
+
+        if (*p == '\n') {
+            pos++;
+            continue;
+        }
+        if (*p == '\r' && pos + 1 < size && p[1] == '\n') {
+            pos += 2;
+            continue;
+        }
+
+        Board b;
+        int used = parse_board_line(p, size - pos, b);
+        if (used < 0)
+            return 1;
+
+        boards.push_back(b);
+        pos += static_cast<std::size_t>(used);
+    }
+
+    return 0;
+}
+
+int load_board_lines(const std::string& filename, std::vector<Board>& boards) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    std::vector<char> buf;
+    std::size_t size;
+    int err = read_fd_fully(fd, buf, size);
+    close(fd);
+
+    if (err)
+        return 1;
+
+    return parse_board_lines(buf.data(), size, boards);
+}
+
+// --------------------------------------------------
+// Loader de um só tabuleiro (um processo por tabuleiro)
+
+int parse_board_file(const char* data, std::size_t size, Board& board) {
+    int idx = 0;
+    for (std::size_t i = 0; i < size && idx < 81; i++) {
+        char c = data[i];
+        if (c >= '0' && c <= '9')
+            board.cells[idx++] = static_cast<std::uint8_t>(c - '0');
+        else if (c != '\n' && c != '\r')
+            return 1;
+    }
+
+    return idx == 81 ? 0 : 1;
+}
+
+int read_file_raw(Board& board, const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    char buf[BOARD_FILE_READ_SIZE];
+    ssize_t n = read(fd, buf, sizeof(buf));
+    close(fd);
+
+    if (n <= 0)
+        return 1;
+
+    return parse_board_file(buf, static_cast<std::size_t>(n), board);
+}
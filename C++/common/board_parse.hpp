@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "board.hpp"
+
+/*
+ * Número de bytes que o parser pode ler a partir do início de uma linha
+ * (81 células + "\r\n" + padding até 3 registos de 32 bytes).
+ * Quem chama tem de garantir que estes bytes são legíveis.
+ */
+static constexpr std::size_t PARSE_WINDOW = 96;
+
+/*
+ * Converte uma linha de 81 caracteres diretamente para "board.cells".
+ * Aceita '1'-'9' como pistas e '0' ou '.' como células vazias.
+ * "avail" é o número de bytes de dados reais a partir de "line"
+ * (o resto da janela de 96 bytes é apenas padding).
+ * Retorna o número de bytes consumidos (81, 82 com '\n' ou 83 com "\r\n"),
+ * ou -1 se a linha tiver caracteres inválidos ou não terminar em 81.
+ * Em caso de erro o conteúdo de "board" não é alterado.
+ */
+int parse_board_line(const char* line, std::size_t avail, Board& board);
+
+/*
+ * Versão escalar do parser (fallback e referência para o benchmark).
+ */
+int parse_board_line_scalar(const char* line, std::size_t avail, Board& board);
+
+/*
+ * Nome da implementação que esta CPU usa ("avx2", "sse4.1" ou "scalar").
+ * parse_board_line escolhe-a ao carregar o executável (common/cpu_dispatch.hpp).
+ */
+const char* parse_board_impl();
+
+/*
+ * Lê tudo o que houver em "fd" para "buf" (funciona também com pipes).
+ * Em "size" fica o número de bytes lidos; o buffer tem PARSE_WINDOW bytes
+ * a zero a seguir aos dados.
+ * Retorna 0 em sucesso, 1 em erro.
+ */
+int read_fd_fully(int fd, std::vector<char>& buf, std::size_t& size);
+
+/*
+ * Converte um buffer com um tabuleiro por linha (com o padding de
+ * read_fd_fully). As linhas vazias são ignoradas.
+ * Retorna 0 em sucesso, 1 se alguma linha for inválida.
+ */
+int parse_board_lines(const char* data, std::size_t size, std::vector<Board>& boards);
+
+/*
+ * Lê um ficheiro com um tabuleiro por linha (formato de 81 caracteres).
+ * As linhas vazias são ignoradas.
+ * Retorna 0 em sucesso, 1 em erro (ficheiro ou linha inválida).
+ */
+int load_board_lines(const std::string& filename, std::vector<Board>& boards);
+
+/*
+ * Bytes lidos de cada ficheiro de um tabuleiro
+ * (9 x 10 bytes, ou 9 x 11 com "\r\n", cabem com folga).
+ */
+static constexpr std::size_t BOARD_FILE_READ_SIZE = 128;
+
+/*
+ * Converte o conteúdo de um ficheiro de tabuleiro (9 linhas de 9 dígitos)
+ * já em memória. Só são aceites dígitos, '\n' e '\r'.
+ * Retorna 0 em sucesso, 1 em erro.
+ */
+int parse_board_file(const char* data, std::size_t size, Board& board);
+
+/*
+ * Lê um tabuleiro (9 linhas de 9 dígitos) com um único open/read/close
+ * para um buffer na stack, sem iostreams nem stdio.
+ * Regras iguais às do read_file da versão em C.
+ * Retorna 0 em sucesso, 1 em erro.
+ */
+int read_file_raw(Board& board, const char* filename);
@@ -0,0 +1,213 @@
+#include "board_stream.hpp"
+#include "board_parse.hpp"
+#include "board_packed.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <unistd.h>
+
+// Uma linha com "\r\n" ocupa 83 bytes; um bloco de 9 linhas até 99
+static constexpr std::size_t MAX_LINE = 83;
+static constexpr std::size_t MAX_GRID = 9 * 11;
+
+// --------------------------------------------------
+// Bloco de 9 linhas de 9 caracteres
+
+static int parse_grid(const char* p, std::size_t avail, Board& board) {
+    std::uint8_t cells[81];
+    std::size_t pos = 0;
+
+    for (int row = 0; row < 9; row++) {
+        if (avail - pos < 9)
+            return -1;
+
+        for (int col = 0; col < 9; col++) {
+            char c = p[pos++];
+            if (c >= '0' && c <= '9')
+                cells[row * 9 + col] = static_cast<std::uint8_t>(c - '0');
+            else if (c == '.')
+                cells[row * 9 + col] = 0;
+            else
+                return -1;
+        }
+
+        // Fim da linha; a última pode acabar no fim dos dados
+        if (pos < avail && p[pos] == '\r')
+            pos++;
+        if (pos < avail && p[pos] == '\n')
+            pos++;
+        else if (row < 8 || pos < avail)
+            return -1;
+    }
+
+    std::memcpy(board.cells.data(), cells, 81);
+    return static_cast<int>(pos);
+}
+
+// --------------------------------------------------
+
+BoardStreamReader::BoardStreamReader(int fd, std::size_t chunk)
+    : fd_(fd), buf_((chunk < 4 * PARSE_WINDOW ? 4 * PARSE_WINDOW : chunk) + PARSE_WINDOW) {}
+
+// Um único read() (bloqueia só se não houver nada para ler)
+bool BoardStreamReader::read_more() {
+    if (eof_ || error_)
+        return false;
+
+    if (begin_ > 0) {
+        std::memmove(buf_.data(), buf_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    std::size_t limit = buf_.size() - PARSE_WINDOW;
+
+    for (;;) {
+        ssize_t n = read(fd_, buf_.data() + end_, limit - end_);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            error_ = true;
+            return false;
+        }
+        if (n == 0)
+            eof_ = true;
+        end_ += static_cast<std::size_t>(n);
+        return n > 0;
+    }
+}
+
+bool BoardStreamReader::fill(std::size_t want) {
+    while (end_ - begin_ < want && read_more()) {
+    }
+    return end_ - begin_ >= want;
+}
+
+// Já há um registo de texto completo no buffer?
+bool BoardStreamReader::has_text_record() const {
+    std::size_t max_len = format_ == Format::GRID ? MAX_GRID : MAX_LINE;
+    int lines = format_ == Format::GRID ? 9 : 1;
+
+    std::size_t avail = end_ - begin_;
+    if (avail >= max_len)
+        return true;
+
+    const char* p = buf_.data() + begin_;
+    int seen = 0;
+    for (std::size_t i = 0; i < avail; i++) {
+        if (p[i] == '\n' && ++seen == lines)
+            return true;
+    }
+    return false;
+}
+
+bool BoardStreamReader::fill_text_record() {
+    while (!has_text_record() && read_more()) {
+    }
+    return !error_;
+}
+
+// Salta linhas vazias; false se não houver mais dados
+bool BoardStreamReader::skip_blank_lines() {
+    for (;;) {
+        if (begin_ == end_ && !fill(1))
+            return false;
+
+        const char* p = buf_.data() + begin_;
+        if (*p == '\n') {
+            begin_++;
+        } else if (*p == '\r') {
+            if (end_ - begin_ < 2 && !fill(2))
+                return true;
+            if (buf_[begin_ + 1] != '\n')
+                return true;
+            begin_ += 2;
+        } else {
+            return true;
+        }
+    }
+}
+
+int BoardStreamReader::detect_format() {
+    fill(sizeof(PackedHeader));
+    if (error_)
+        return -1;
+
+    if (is_packed_data(buf_.data() + begin_, end_ - begin_)) {
+        format_ = Format::PACKED;
+        begin_ += sizeof(PackedHeader);
+        return 0;
+    }
+
+    // Texto: o tamanho da primeira linha decide (9 -> blocos, senão linhas)
+    format_ = Format::LINES;
+    if (!skip_blank_lines() || !fill_text_record())
+        return error_ ? -1 : 0;
+
+    const char* p = buf_.data() + begin_;
+    std::size_t avail = end_ - begin_;
+    if ((avail > 9 && p[9] == '\n') || (avail > 10 && p[9] == '\r' && p[10] == '\n'))
+        format_ = Format::GRID;
+
+    return 0;
+}
+
+bool BoardStreamReader::would_block() const {
+    if (eof_ || error_)
+        return false;
+    if (format_ == Format::PACKED)
+        return end_ - begin_ < PACKED_BOARD_SIZE;
+    if (format_ == Format::UNKNOWN)
+        return end_ - begin_ < sizeof(PackedHeader);
+    return !has_text_record();
+}
+
+int BoardStreamReader::next(Board& board) {
+    if (format_ == Format::UNKNOWN && detect_format() < 0)
+        return -1;
+
+    if (format_ == Format::PACKED) {
+        if (!fill(PACKED_BOARD_SIZE))
+            return (error_ || end_ != begin_) ? -1 : 0;
+
+        PackedBoard pb;
+        std::memcpy(pb.bytes.data(), buf_.data() + begin_, PACKED_BOARD_SIZE);
+        if (unpack_board(pb, board) != 0)
+            return -1; // nibble > 9, como um carácter inválido numa linha
+        begin_ += PACKED_BOARD_SIZE;
+        return 1;
+    }
+
+    if (!skip_blank_lines())
+        return error_ ? -1 : 0;
+    if (!fill_text_record())
+        return -1;
+
+    const char* p = buf_.data() + begin_;
+    std::size_t avail = end_ - begin_;
+
+    int used = format_ == Format::GRID ? parse_grid(p, avail, board)
+                                       : parse_board_line(p, avail, board);
+    if (used < 0)
+        return -1;
+
+    begin_ += static_cast<std::size_t>(used);
+    return 1;
+}
+
+std::size_t BoardStreamReader::next_batch(Board* out, std::size_t max, int& status) {
+    std::size_t count = 0;
+    status = 1;
+
+    while (count < max) {
+        int r = next(out[count]);
+        if (r != 1) {
+            status = r;
+            break;
+        }
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "board.hpp"
+
+/*
+ * Leitor incremental de tabuleiros a partir de um descritor (ficheiro,
+ * pipe, stdin), com um buffer de tamanho fixo: a memória não depende do
+ * tamanho da entrada.
+ * O formato é detetado pelos primeiros bytes:
+ *   - linhas de 81 caracteres;
+ *   - blocos de 9 linhas de 9 caracteres (como os ficheiros em boards/);
+ *   - binário compacto (board_packed.hpp).
+ * Só se chama read() quando o registo seguinte ainda não está no buffer,
+ * por isso funciona também com entrada interativa.
+ */
+class BoardStreamReader {
+public:
+    static constexpr std::size_t DEFAULT_CHUNK = 1 << 20;
+
+    explicit BoardStreamReader(int fd, std::size_t chunk = DEFAULT_CHUNK);
+
+    /*
+     * Lê o próximo tabuleiro.
+     * Retorna 1 se leu um tabuleiro, 0 no fim da entrada, -1 em erro
+     * (linha inválida ou falha de leitura).
+     */
+    int next(Board& board);
+
+    /*
+     * Lê até "max" tabuleiros para "out".
+     * Retorna quantos leu; "status" fica com 0 (fim), 1 (há mais) ou -1.
+     */
+    std::size_t next_batch(Board* out, std::size_t max, int& status);
+
+    /*
+     * true se o próximo next() tiver de esperar por read()
+     * (útil para fazer flush da saída antes de bloquear).
+     */
+    bool would_block() const;
+
+private:
+    enum class Format { UNKNOWN, LINES, GRID, PACKED };
+
+    bool read_more();
+    bool fill(std::size_t want);
+    bool has_text_record() const;
+    bool fill_text_record();
+    bool skip_blank_lines();
+    int detect_format();
+
+    int fd_;
+    Format format_ = Format::UNKNOWN;
+    std::vector<char> buf_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    bool eof_ = false;
+    bool error_ = false;
+};
@@ -0,0 +1,100 @@
+#include "board_writer.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// --------------------------------------------------
+
+void format_board_line(const Board& board, char* out) {
+    const std::uint8_t* cells = board.cells.data();
+
+#if defined(__SSE2__)
+    // 5 x 16 células com um único add de '0' cada
+    const __m128i zero_ch = _mm_set1_epi8('0');
+    for (int i = 0; i < 80; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi8(v, zero_ch));
+    }
+    out[80] = static_cast<char>('0' + cells[80]);
+#else
+    for (int i = 0; i < 81; i++)
+        out[i] = static_cast<char>('0' + cells[i]);
+#endif
+
+    out[81] = '\n';
+}
+
+// --------------------------------------------------
+
+BoardWriter::BoardWriter(int fd, BoardFormat format, std::size_t capacity)
+    : fd_(fd),
+      format_(format),
+      record_size_(format == BoardFormat::PACKED ? PACKED_BOARD_SIZE : LINE_SIZE),
+      buf_(capacity < sizeof(PackedHeader) + LINE_SIZE ? sizeof(PackedHeader) + LINE_SIZE : capacity) {
+    if (format_ == BoardFormat::PACKED) {
+        PackedHeader h = make_packed_header(0);
+        std::memcpy(buf_.data(), &h, sizeof(h));
+        used_ = sizeof(h);
+
+        // O cabeçalho vai para a posição atual do descritor; com O_APPEND
+        // o pwrite do contador seria acrescentado no fim do ficheiro
+        int flags = fcntl(fd_, F_GETFL);
+        off_t pos = lseek(fd_, 0, SEEK_CUR);
+        if (flags >= 0 && !(flags & O_APPEND) && pos >= 0)
+            header_offset_ = pos;
+    }
+}
+
+BoardWriter::~BoardWriter() {
+    flush();
+
+    if (!failed_ && header_offset_ >= 0) {
+        std::uint64_t count = boards_;
+        (void)::pwrite(fd_, &count, sizeof(count),
+                       header_offset_ + static_cast<off_t>(offsetof(PackedHeader, count)));
+    }
+}
+
+void BoardWriter::write_board(const Board& board) {
+    if (used_ + record_size_ > buf_.size())
+        flush();
+
+    if (format_ == BoardFormat::PACKED) {
+        PackedBoard pb;
+        pack_board(board, pb);
+        std::memcpy(buf_.data() + used_, pb.bytes.data(), PACKED_BOARD_SIZE);
+    } else {
+        format_board_line(board, buf_.data() + used_);
+    }
+
+    used_ += record_size_;
+    boards_++;
+}
+
+int BoardWriter::flush() {
+    std::size_t done = 0;
+
+    while (!failed_ && done < used_) {
+        ssize_t n = ::write(fd_, buf_.data() + done, used_ - done);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            failed_ = true;
+            break;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+
+    used_ = 0;
+
+    return failed_ ? 1 : 0;
+}
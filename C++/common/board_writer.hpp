@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "board.hpp"
+#include "board_packed.hpp"
+
+/*
+ * Escreve os 81 dígitos de "board" seguidos de '\n' em "out"
+ * (82 bytes). As células vazias ficam como '0'.
+ */
+void format_board_line(const Board& board, char* out);
+
+enum class BoardFormat {
+    LINES,  // 81 dígitos + '\n'
+    PACKED  // cabeçalho + 41 bytes por tabuleiro (board_packed.hpp)
+};
+
+/*
+ * Writer em bloco para muitas soluções: formata os tabuleiros num buffer
+ * pré-alocado e só chama write() quando o buffer enche
+ * (ou em flush()/destrutor).
+ * No formato PACKED o contador do cabeçalho é escrito uma única vez, no
+ * destrutor, e só se o descritor for seekable e não tiver O_APPEND; num
+ * pipe, com O_APPEND ou após um erro fica a 0 ("até ao fim").
+ */
+class BoardWriter {
+public:
+    static constexpr std::size_t LINE_SIZE = 82;
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+    explicit BoardWriter(int fd,
+                         BoardFormat format = BoardFormat::LINES,
+                         std::size_t capacity = DEFAULT_CAPACITY);
+    ~BoardWriter();
+
+    BoardWriter(const BoardWriter&) = delete;
+    BoardWriter& operator=(const BoardWriter&) = delete;
+
+    void write_board(const Board& board);
+
+    /*
+     * Escreve todo o buffer no descritor.
+     * Retorna 0 em sucesso, 1 em erro (tal como read_file).
+     */
+    int flush();
+
+    std::size_t boards_written() const { return boards_; }
+
+private:
+    int fd_;
+    BoardFormat format_;
+    std::size_t record_size_;
+    std::vector<char> buf_;
+    std::size_t used_ = 0;
+    std::size_t boards_ = 0;
+    bool failed_ = false;
+    // Posição do cabeçalho no ficheiro, ou -1 se não for possível corrigi-lo
+    off_t header_offset_ = -1;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+/*
+ * Despacho por CPU em tempo de execução.
+ *
+ * As procuras com máscaras de bits (bitmasking, bitmasking_fc, hybrid) são
+ * compiladas para vários níveis x86-64 no mesmo executável com
+ * SUDOKU_DISPATCH (target_clones):
+ *   default   : x86-64 base (popcount via libgcc)
+ *   x86-64-v2 : SSE4.2 + POPCNT
+ *   x86-64-v3 : AVX2 + BMI1/BMI2 + LZCNT
+ *   x86-64-v4 : AVX-512 (F, BW, CD, DQ, VL)
+ * O resolver (ifunc) usa cpuid uma vez, ao carregar o executável, e
+ * escolhe a melhor versão suportada. As chamadas recursivas ficam dentro
+ * da mesma versão; só a primeira chamada de cada solve é indireta.
+ * As funções auxiliares quentes são always_inline, para serem compiladas
+ * dentro de cada versão.
+ *
+ * Os kernels com intrínsecas escritas à mão (parser, empacotamento) têm
+ * código próprio por nível e não podem usar target_clones: cada versão é
+ * compilada com SUDOKU_TARGET e um resolver ifunc escolhe uma ao carregar
+ * o executável, com as funções cpu_has_*() abaixo.
+ *
+ * Por isso o makefile não usa -march=native por omissão: o mesmo binário
+ * corre em qualquer x86-64 com o melhor código da máquina.
+ * Fora de x86-64 fica uma só versão. Com -DSUDOKU_NO_DISPATCH também, e
+ * os kernels seguem as flags da compilação (-march).
+ */
+
+// Os níveis, em nomes de __builtin_cpu_supports (com "arch=" para target_clones)
+#define SUDOKU_LEVEL_V2 "x86-64-v2"
+#define SUDOKU_LEVEL_V3 "x86-64-v3"
+#define SUDOKU_LEVEL_V4 "x86-64-v4"
+
+#if defined(__x86_64__) && !defined(SUDOKU_NO_DISPATCH)
+#define SUDOKU_DISPATCH                                                \
+    __attribute__((target_clones("default", "arch=" SUDOKU_LEVEL_V2,  \
+                                 "arch=" SUDOKU_LEVEL_V3, "arch=" SUDOKU_LEVEL_V4)))
+#else
+#define SUDOKU_DISPATCH
+#endif
+
+#if defined(__x86_64__)
+#define SUDOKU_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/*
+ * Versão que o resolver escolhe nesta máquina: o resolver de target_clones
+ * testa __builtin_cpu_supports com cada nível, do mais alto para o mais
+ * baixo, e aqui a chamada é a mesma. "x86-64-v4", ..., ou "default".
+ */
+inline const char* cpu_dispatch_level() {
+#if defined(__x86_64__) && !defined(SUDOKU_NO_DISPATCH)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports(SUDOKU_LEVEL_V4))
+        return SUDOKU_LEVEL_V4;
+    if (__builtin_cpu_supports(SUDOKU_LEVEL_V3))
+        return SUDOKU_LEVEL_V3;
+    if (__builtin_cpu_supports(SUDOKU_LEVEL_V2))
+        return SUDOKU_LEVEL_V2;
+#endif
+    return "default";
+}
+
+// Extensões dos kernels: testadas na CPU ou, sem despacho, as da compilação
+#if defined(__x86_64__) && !defined(SUDOKU_NO_DISPATCH)
+inline bool cpu_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+inline bool cpu_has_sse41() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+}
+
+inline bool cpu_has_ssse3() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+}
+#elif defined(__x86_64__)
+inline bool cpu_has_avx2() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_has_sse41() {
+#if defined(__SSE4_1__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_has_ssse3() {
+#if defined(__SSSE3__)
+    return true;
+#else
+    return false;
+#endif
+}
+#endif
+
+/*
+ * Com SUDOKU_CPU_LOG definida, escreve "cpu dispatch: <versão>" no stderr.
+ * Só write(), para poder ser usada nos lean_*.exe (sem stdio).
+ */
+inline void cpu_dispatch_log() {
+    if (!std::getenv("SUDOKU_CPU_LOG"))
+        return;
+
+    char line[64] = "cpu dispatch: ";
+    std::strcat(line, cpu_dispatch_level());
+    std::strcat(line, "\n");
+    ssize_t ignored = write(STDERR_FILENO, line, std::strlen(line));
+    (void)ignored;
+}
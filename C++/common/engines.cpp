@@ -0,0 +1,29 @@
+#include "engines.hpp"
+
+#include <cstring>
+
+#include "../unoptimized/sudoku_unoptimize.hpp"
+#include "../bitmaskingrmv/sudoku_bitmasking_rmv.hpp"
+#include "../bitmaskingrmvfc/sudoku_bitmasking_rmv_fc.hpp"
+#include "../dlx/sudoku_dlx.hpp"
+#include "../hybrid/sudoku_hybrid.hpp"
+
+static const Engine ENGINES[] = {
+    {"unoptimized",   "Unoptimized",                 solve_unoptimized},
+    {"bitmasking",    "Bitmasking+MRV",              solve_bitmasking},
+    {"bitmasking_fc", "Bitmasking+MRV+FC",           solve_bitmasking_fc},
+    {"dlx",           "DLX (Algorithm X)",           solve_dlx},
+    {"hybrid",        "Hybrid (MRV+FC+LCV+Bitmask)", solve_hybrid},
+};
+
+const Engine* engines_begin() { return ENGINES; }
+const Engine* engines_end() { return ENGINES + engine_count(); }
+std::size_t engine_count() { return sizeof(ENGINES) / sizeof(ENGINES[0]); }
+
+const Engine* find_engine(const char* name) {
+    for (const Engine* e = engines_begin(); e != engines_end(); e++) {
+        if (std::strcmp(e->name, name) == 0)
+            return e;
+    }
+    return nullptr;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include "board.hpp"
+
+/*
+ * Registo de todos os solvers, para executáveis que os usam em conjunto
+ * (benchmark, ...).
+ *
+ * Cada solver exporta solve_<nome>, e este registo só usa esses nomes.
+ * Os nomes genéricos read_file/solve/print_board ficam num objeto à parte
+ * por solver (<solver>_generic.cpp), ligado só nos executáveis de um só
+ * solver (sudoku_*.exe, lean_*, batch_*, pipeline_*, server_*, ...). Os
+ * executáveis e bibliotecas com vários solvers não os têm.
+ *
+ * Com -DSUDOKU_LEAN (executáveis lean_*, ver main_lean.cpp) read_file e
+ * print_board não são compilados, para não incluir <iostream>.
+ */
+
+using SolveFn = int (*)(const Board& input, Board& solution);
+
+struct Engine {
+    const char* name;  // como em benchmark.py ("dlx", "bitmasking_fc", ...)
+    const char* label; // para relatórios
+    SolveFn solve;
+};
+
+/*
+ * Todos os solvers, pela ordem de benchmark.py.
+ */
+const Engine* engines_begin();
+const Engine* engines_end();
+std::size_t engine_count();
+
+/*
+ * Procura um solver pelo nome. Retorna nullptr se não existir.
+ */
+const Engine* find_engine(const char* name);
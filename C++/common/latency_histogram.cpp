@@ -0,0 +1,276 @@
+#include "latency_histogram.hpp"
+
+#include <cmath>
+#include <cstring>
+
+// --------------------------------------------------
+// LatencyHistogram
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++)
+        counts_[i] += other.counts_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    if (other.min_ < min_)
+        min_ = other.min_;
+    if (other.max_ > max_)
+        max_ = other.max_;
+}
+
+std::uint64_t LatencyHistogram::bucket_low(std::size_t index) {
+    if (index < SUB_BUCKETS)
+        return index;
+    std::uint64_t k = index - SUB_BUCKETS;
+    int shift = static_cast<int>(k / HALF_BUCKETS) + 1;
+    std::uint64_t sub = k % HALF_BUCKETS + HALF_BUCKETS;
+    return sub << shift;
+}
+
+std::uint64_t LatencyHistogram::bucket_high(std::size_t index) {
+    if (index < SUB_BUCKETS)
+        return index;
+    std::uint64_t k = index - SUB_BUCKETS;
+    int shift = static_cast<int>(k / HALF_BUCKETS) + 1;
+    std::uint64_t sub = k % HALF_BUCKETS + HALF_BUCKETS;
+    return ((sub + 1) << shift) - 1; // o último bucket dá 2^64 - 1
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0)
+        return 0;
+
+    // Posição (1..count) da amostra pedida
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * double(count_)));
+    if (rank < 1)
+        rank = 1;
+    if (rank >= count_)
+        return max_;
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            std::uint64_t high = bucket_high(i);
+            return high < max_ ? high : max_;
+        }
+    }
+    return max_;
+}
+
+// --------------------------------------------------
+// Dificuldade
+
+Difficulty difficulty_of(const Board& board) {
+    int clues = 0;
+    for (std::uint8_t v : board.cells)
+        clues += v != 0;
+
+    if (clues >= 36)
+        return DIFF_EASY;
+    if (clues >= 30)
+        return DIFF_MEDIUM;
+    if (clues >= 24)
+        return DIFF_HARD;
+    return DIFF_MINIMAL;
+}
+
+const char* difficulty_name(int difficulty) {
+    switch (difficulty) {
+        case DIFF_EASY:    return "easy";
+        case DIFF_MEDIUM:  return "medium";
+        case DIFF_HARD:    return "hard";
+        case DIFF_MINIMAL: return "minimal";
+    }
+    return "unknown";
+}
+
+// --------------------------------------------------
+// LatencyReport
+
+LatencyReport::Entry& LatencyReport::engine(const std::string& name) {
+    for (Entry& e : entries_) {
+        if (e.engine == name)
+            return e;
+    }
+    entries_.emplace_back();
+    entries_.back().engine = name;
+    return entries_.back();
+}
+
+void LatencyReport::merge(const LatencyReport& other) {
+    for (const Entry& src : other.entries_) {
+        Entry& dst = engine(src.engine);
+        for (int d = 0; d < DIFFICULTY_COUNT; d++)
+            dst.by_difficulty[d].merge(src.by_difficulty[d]);
+    }
+}
+
+static void print_histogram_row(FILE* out, const char* engine, const char* difficulty,
+                                 const LatencyHistogram& h) {
+    std::fprintf(out, "%-14s %-8s %10llu %12.0f %12llu %12llu %12llu %12llu\n", engine, difficulty,
+                 static_cast<unsigned long long>(h.count()), h.mean(),
+                 static_cast<unsigned long long>(h.percentile(50)),
+                 static_cast<unsigned long long>(h.percentile(99)),
+                 static_cast<unsigned long long>(h.percentile(99.9)),
+                 static_cast<unsigned long long>(h.max()));
+}
+
+void LatencyReport::print(FILE* out) const {
+    std::fprintf(out, "%-14s %-8s %10s %12s %12s %12s %12s %12s\n", "engine", "class", "count",
+                 "mean_ns", "p50_ns", "p99_ns", "p99.9_ns", "max_ns");
+
+    for (const Entry& e : entries_) {
+        LatencyHistogram all;
+        for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+            const LatencyHistogram& h = e.by_difficulty[d];
+            if (h.count() == 0)
+                continue;
+            print_histogram_row(out, e.engine.c_str(), difficulty_name(d), h);
+            all.merge(h);
+        }
+        print_histogram_row(out, e.engine.c_str(), "all", all);
+    }
+}
+
+int LatencyReport::write_csv(const char* path) const {
+    FILE* f = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "w");
+    if (!f)
+        return 1;
+
+    std::fprintf(f, "engine,difficulty,bucket_low_ns,bucket_high_ns,count\n");
+    for (const Entry& e : entries_) {
+        for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+            const LatencyHistogram& h = e.by_difficulty[d];
+            for (std::size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+                if (h.counts_[i] == 0)
+                    continue;
+                std::fprintf(f, "%s,%s,%llu,%llu,%llu\n", e.engine.c_str(), difficulty_name(d),
+                             static_cast<unsigned long long>(LatencyHistogram::bucket_low(i)),
+                             static_cast<unsigned long long>(LatencyHistogram::bucket_high(i)),
+                             static_cast<unsigned long long>(h.counts_[i]));
+            }
+        }
+    }
+
+    int err = std::ferror(f) ? 1 : 0;
+    if (f != stdout)
+        err |= std::fclose(f) != 0;
+    return err;
+}
+
+// --------------------------------------------------
+// Formato binário (little-endian, como o formato compacto):
+//   "SDKHIST1", u32 SUB_BUCKET_BITS, u32 número de histogramas
+//   por histograma: u32 tamanho do nome, nome, u32 dificuldade,
+//                   u64 count, sum, min, max, u32 buckets não vazios,
+//                   { u32 índice, u64 count } por bucket
+
+static const char HIST_MAGIC[8] = {'S', 'D', 'K', 'H', 'I', 'S', 'T', '1'};
+
+static bool write_u32(FILE* f, std::uint32_t v) { return std::fwrite(&v, sizeof(v), 1, f) == 1; }
+static bool write_u64(FILE* f, std::uint64_t v) { return std::fwrite(&v, sizeof(v), 1, f) == 1; }
+static bool read_u32(FILE* f, std::uint32_t& v) { return std::fread(&v, sizeof(v), 1, f) == 1; }
+static bool read_u64(FILE* f, std::uint64_t& v) { return std::fread(&v, sizeof(v), 1, f) == 1; }
+
+int LatencyReport::save(const char* path) const {
+    FILE* f = std::fopen(path, "wb");
+    if (!f)
+        return 1;
+
+    std::uint32_t histograms = 0;
+    for (const Entry& e : entries_) {
+        for (const LatencyHistogram& h : e.by_difficulty)
+            histograms += h.count() > 0;
+    }
+
+    bool ok = std::fwrite(HIST_MAGIC, sizeof(HIST_MAGIC), 1, f) == 1 &&
+              write_u32(f, LatencyHistogram::SUB_BUCKET_BITS) && write_u32(f, histograms);
+
+    for (const Entry& e : entries_) {
+        for (int d = 0; d < DIFFICULTY_COUNT && ok; d++) {
+            const LatencyHistogram& h = e.by_difficulty[d];
+            if (h.count() == 0)
+                continue;
+
+            std::uint32_t used = 0;
+            for (std::uint64_t c : h.counts_)
+                used += c != 0;
+
+            ok = write_u32(f, static_cast<std::uint32_t>(e.engine.size())) &&
+                 std::fwrite(e.engine.data(), 1, e.engine.size(), f) == e.engine.size() &&
+                 write_u32(f, static_cast<std::uint32_t>(d)) && write_u64(f, h.count_) &&
+                 write_u64(f, h.sum_) && write_u64(f, h.min_) && write_u64(f, h.max_) &&
+                 write_u32(f, used);
+
+            for (std::size_t i = 0; i < LatencyHistogram::BUCKET_COUNT && ok; i++) {
+                if (h.counts_[i] != 0)
+                    ok = write_u32(f, static_cast<std::uint32_t>(i)) && write_u64(f, h.counts_[i]);
+            }
+        }
+    }
+
+    ok = std::fclose(f) == 0 && ok;
+    return ok ? 0 : 1;
+}
+
+int LatencyReport::load(const char* path) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f)
+        return 1;
+
+    char magic[sizeof(HIST_MAGIC)];
+    std::uint32_t bits = 0;
+    std::uint32_t histograms = 0;
+    bool ok = std::fread(magic, sizeof(magic), 1, f) == 1 &&
+              std::memcmp(magic, HIST_MAGIC, sizeof(magic)) == 0 && read_u32(f, bits) &&
+              bits == LatencyHistogram::SUB_BUCKET_BITS && read_u32(f, histograms);
+
+    for (std::uint32_t n = 0; n < histograms && ok; n++) {
+        std::uint32_t name_size = 0;
+        std::uint32_t d = 0;
+        std::uint32_t used = 0;
+        LatencyHistogram h;
+
+        ok = read_u32(f, name_size) && name_size <= 256;
+        std::string name(ok ? name_size : 0, '\0');
+        ok = ok && std::fread(&name[0], 1, name_size, f) == name_size && read_u32(f, d) &&
+             d < DIFFICULTY_COUNT && read_u64(f, h.count_) && read_u64(f, h.sum_) &&
+             read_u64(f, h.min_) && read_u64(f, h.max_) && read_u32(f, used);
+
+        for (std::uint32_t i = 0; i < used && ok; i++) {
+            std::uint32_t index = 0;
+            std::uint64_t count = 0;
+            ok = read_u32(f, index) && read_u64(f, count) && index < LatencyHistogram::BUCKET_COUNT;
+            if (ok)
+                h.counts_[index] = count;
+        }
+
+        if (ok)
+            engine(name).by_difficulty[d].merge(h);
+    }
+
+    std::fclose(f);
+    return ok ? 0 : 1;
+}
+
+// --------------------------------------------------
+
+std::string engine_name_from_program(const char* argv0) {
+    std::string name = argv0;
+    std::size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos)
+        name.erase(0, slash + 1);
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".exe") == 0)
+        name.erase(name.size() - 4);
+
+    std::size_t underscore = name.find('_');
+    if (underscore != std::string::npos)
+        name.erase(0, underscore + 1); // batch_, pipeline_, sudoku_, ...
+
+    // Os nomes de common/engines.hpp (e de benchmark.py)
+    if (name == "bitmaskingrmv")
+        return "bitmasking";
+    if (name == "bitmaskingrmv_fc")
+        return "bitmasking_fc";
+    return name;
+}
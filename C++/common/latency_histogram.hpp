@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "board.hpp"
+
+/*
+ * Histogramas de latência log-lineares (como o HdrHistogram).
+ *
+ * Cada potência de 2 está dividida em 64 sub-buckets, por isso o erro
+ * relativo de um percentil é < 1/64 (~1.6%) em toda a gama, de 1 ns até
+ * 2^64 ns, com um array fixo de contadores. record() é só um índice
+ * (clz + shift) e um incremento, sem alocações.
+ *
+ * Não há sincronização: cada thread tem os seus histogramas e no fim
+ * faz-se merge() (somar contadores), como no pipeline.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t(1) << SUB_BUCKET_BITS; // 128
+    static constexpr std::uint64_t HALF_BUCKETS = SUB_BUCKETS / 2;                     // 64
+    static constexpr std::size_t BUCKET_COUNT =
+        SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * HALF_BUCKETS;
+
+    LatencyHistogram() : counts_(BUCKET_COUNT, 0) {}
+
+    void record(std::uint64_t ns) {
+        counts_[bucket_index(ns)]++;
+        count_++;
+        sum_ += ns;
+        if (ns < min_)
+            min_ = ns;
+        if (ns > max_)
+            max_ = ns;
+    }
+
+    void merge(const LatencyHistogram& other);
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t min() const { return count_ ? min_ : 0; }
+    std::uint64_t max() const { return max_; }
+    double mean() const { return count_ ? double(sum_) / double(count_) : 0; }
+
+    /*
+     * Valor abaixo do qual estão "p"% (0-100) das amostras: o limite
+     * superior do bucket correspondente (nunca acima de max()).
+     */
+    std::uint64_t percentile(double p) const;
+
+    static std::size_t bucket_index(std::uint64_t ns) {
+        if (ns < SUB_BUCKETS)
+            return static_cast<std::size_t>(ns);
+        int exponent = 63 - __builtin_clzll(ns);    // >= SUB_BUCKET_BITS
+        int shift = exponent - (SUB_BUCKET_BITS - 1); // (ns >> shift) em [64, 128)
+        return static_cast<std::size_t>(SUB_BUCKETS + std::uint64_t(shift - 1) * HALF_BUCKETS +
+                                        ((ns >> shift) - HALF_BUCKETS));
+    }
+
+    static std::uint64_t bucket_low(std::size_t index);
+    static std::uint64_t bucket_high(std::size_t index);
+
+private:
+    friend class LatencyReport;
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+};
+
+/*
+ * Classe de dificuldade de um tabuleiro, pelo número de pistas.
+ * É só uma aproximação (há tabuleiros com muitas pistas e muito
+ * backtracking), mas não precisa de instrumentar os solvers.
+ */
+enum Difficulty {
+    DIFF_EASY,    // >= 36 pistas
+    DIFF_MEDIUM,  // 30-35
+    DIFF_HARD,    // 24-29
+    DIFF_MINIMAL, // <= 23 (perto do mínimo de 17)
+    DIFFICULTY_COUNT
+};
+
+Difficulty difficulty_of(const Board& board);
+const char* difficulty_name(int difficulty);
+
+/*
+ * Histogramas por solver x classe de dificuldade.
+ * Um LatencyReport por thread; no fim merge() para um só.
+ */
+class LatencyReport {
+public:
+    struct Entry {
+        std::string engine;
+        LatencyHistogram by_difficulty[DIFFICULTY_COUNT];
+    };
+
+    // Histogramas de "engine" (criados na primeira chamada)
+    Entry& engine(const std::string& name);
+
+    void record(Entry& entry, const Board& board, std::uint64_t ns) {
+        entry.by_difficulty[difficulty_of(board)].record(ns);
+    }
+
+    void merge(const LatencyReport& other);
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    /*
+     * Tabela com count/mean/p50/p99/p99.9/max por solver e por classe
+     * (e o total de cada solver).
+     */
+    void print(FILE* out) const;
+
+    /*
+     * CSV com um bucket por linha:
+     *   engine,difficulty,bucket_low_ns,bucket_high_ns,count
+     * (só buckets não vazios; dois CSV juntam-se somando os counts).
+     */
+    int write_csv(const char* path) const;
+
+    /*
+     * Formato binário para guardar e juntar corridas (hist_report.exe).
+     * Retornam 0 em sucesso, 1 em erro (tal como read_file).
+     * load() junta o conteúdo do ficheiro ao que já existe.
+     */
+    int save(const char* path) const;
+    int load(const char* path);
+
+private:
+    std::vector<Entry> entries_;
+};
+
+/*
+ * Nome do solver a partir do nome do executável
+ * ("./batch_dlx.exe" -> "dlx"), para os executáveis de um só solver.
+ */
+std::string engine_name_from_program(const char* argv0);
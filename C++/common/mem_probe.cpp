@@ -0,0 +1,148 @@
+#include "mem_probe.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// operator new/delete a contar
+
+static thread_local AllocCount counts;
+static thread_local bool counting = false;
+
+static void* counted_alloc(std::size_t n) {
+    if (counting) {
+        counts.allocs++;
+        counts.bytes += n;
+    }
+    return std::malloc(n ? n : 1);
+}
+
+AllocCount alloc_count() {
+    return counts;
+}
+
+AllocCounting::AllocCounting() : previous_(counting) {
+    counting = true;
+}
+
+AllocCounting::~AllocCounting() {
+    counting = previous_;
+}
+
+void* operator new(std::size_t n) {
+    void* p = counted_alloc(n);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t n) {
+    void* p = counted_alloc(n);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    return counted_alloc(n);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    return counted_alloc(n);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+// --------------------------------------------------
+// Pilha pintada
+
+static constexpr unsigned char PAINT = 0xA5;
+
+// makecontext só passa ints: a chamada vai por aqui
+// (namespace anónimo: o nome não pode colidir com tipos de quem liga este objeto)
+namespace {
+struct ProbeCall {
+    void (*fn)(void*);
+    void* arg;
+};
+} // namespace
+static thread_local ProbeCall current;
+
+static void trampoline() {
+    current.fn(current.arg);
+}
+
+static void nothing(void*) {}
+
+StackProbe::StackProbe(std::size_t size) {
+    std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    size_ = (size + page - 1) / page * page;
+    map_size_ = size_ + page;
+
+    void* p = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        return;
+    base_ = static_cast<unsigned char*>(p);
+    mprotect(base_, page, PROT_NONE);
+
+    overhead_ = measure(nothing, nullptr);
+}
+
+StackProbe::~StackProbe() {
+    if (base_)
+        munmap(base_, map_size_);
+}
+
+std::size_t StackProbe::measure(void (*fn)(void*), void* arg) {
+    unsigned char* stack = base_ + (map_size_ - size_);
+    std::memset(stack, PAINT, size_);
+
+    ucontext_t caller, probe;
+    getcontext(&probe);
+    probe.uc_stack.ss_sp = stack;
+    probe.uc_stack.ss_size = size_;
+    probe.uc_link = &caller;
+    current = {fn, arg};
+    makecontext(&probe, trampoline, 0);
+    swapcontext(&caller, &probe);
+
+    // A pilha cresce para baixo: o primeiro byte alterado a contar de baixo
+    std::size_t untouched = 0;
+    while (untouched < size_ && stack[untouched] == PAINT)
+        untouched++;
+    return size_ - untouched;
+}
+
+std::size_t StackProbe::run(void (*fn)(void*), void* arg) {
+    if (!base_)
+        return 0;
+    std::size_t used = measure(fn, arg);
+    return used > overhead_ ? used - overhead_ : 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Memória de uma chamada: alocações no heap e pilha máxima.
+ *
+ * mem_probe.cpp substitui o operator new/delete global por versões que
+ * contam, por thread, as chamadas e os bytes pedidos (antes de ir ao
+ * malloc). Só é ligado no benchmark.exe: os outros executáveis ficam com o
+ * allocator normal. A contagem está desligada por omissão e só a passagem
+ * de memória a liga (AllocCounting), para as passagens cronometradas e
+ * de contadores não pagarem o incremento. O new alinhado
+ * (std::align_val_t) não é contado; nenhum solver o usa.
+ *
+ * A pilha é medida por pintura: a função corre numa pilha própria (mmap,
+ * com uma página de guarda em baixo), cheia com um padrão antes da chamada;
+ * depois, o byte mais baixo que já não tem o padrão dá a profundidade
+ * máxima. O custo fixo do trampolim (ucontext) é descontado.
+ */
+
+struct AllocCount {
+    std::uint64_t allocs = 0; // chamadas a operator new / new[]
+    std::uint64_t bytes = 0;  // bytes pedidos
+};
+
+// Contagem da thread atual (subtrair duas leituras)
+AllocCount alloc_count();
+
+// Liga a contagem na thread atual enquanto o objeto existir
+class AllocCounting {
+public:
+    AllocCounting();
+    ~AllocCounting();
+
+    AllocCounting(const AllocCounting&) = delete;
+    AllocCounting& operator=(const AllocCounting&) = delete;
+
+private:
+    bool previous_;
+};
+
+class StackProbe {
+public:
+    static constexpr std::size_t DEFAULT_SIZE = 1 << 20;
+
+    explicit StackProbe(std::size_t size = DEFAULT_SIZE);
+    ~StackProbe();
+
+    StackProbe(const StackProbe&) = delete;
+    StackProbe& operator=(const StackProbe&) = delete;
+
+    bool available() const { return base_ != nullptr; }
+
+    /*
+     * Chama fn(arg) na pilha pintada e retorna os bytes de pilha que usou.
+     * Uma chamada que passe de "size" bytes termina na página de guarda
+     * (SIGSEGV), não escreve por cima de outra memória.
+     */
+    std::size_t run(void (*fn)(void*), void* arg);
+
+private:
+    std::size_t measure(void (*fn)(void*), void* arg);
+
+    unsigned char* base_ = nullptr; // início do mmap (página de guarda)
+    std::size_t map_size_ = 0;
+    std::size_t size_ = 0;          // pilha utilizável, acima da guarda
+    std::size_t overhead_ = 0;      // bytes do trampolim, sem fn
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/*
+ * Fila circular limitada, lock-free, com vários produtores e consumidores
+ * (algoritmo de D. Vyukov: cada posição tem um número de sequência).
+ * A capacidade é arredondada para uma potência de 2.
+ *
+ * push()/pop() bloqueiam com spin + yield quando a fila está cheia/vazia
+ * (backpressure) e contam quantas vezes tiveram de esperar.
+ * Depois de close(), pop() devolve false assim que a fila fica vazia.
+ */
+template <typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+
+        mask_ = cap - 1;
+        cells_.reset(new Cell[cap]);
+        for (std::size_t i = 0; i < cap; i++)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    bool try_push(const T& value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // cheia
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(T& out) {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            std::size_t seq = cell.seq.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = cell.value;
+                    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // vazia
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(const T& value) {
+        if (try_push(value))
+            return;
+
+        full_waits_.fetch_add(1, std::memory_order_relaxed);
+        for (int spins = 0; !try_push(value); spins++)
+            backoff(spins);
+    }
+
+    bool pop(T& out) {
+        if (try_pop(out))
+            return true;
+
+        empty_waits_.fetch_add(1, std::memory_order_relaxed);
+        for (int spins = 0;; spins++) {
+            if (try_pop(out))
+                return true;
+            if (closed_.load(std::memory_order_acquire))
+                return try_pop(out);
+            backoff(spins);
+        }
+    }
+
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    std::size_t capacity() const { return mask_ + 1; }
+    std::uint64_t full_waits() const { return full_waits_.load(std::memory_order_relaxed); }
+    std::uint64_t empty_waits() const { return empty_waits_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+    static void backoff(int spins) {
+        if (spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    // head e tail em linhas de cache diferentes (evita false sharing)
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<bool> closed_{false};
+    std::atomic<std::uint64_t> full_waits_{0};
+    std::atomic<std::uint64_t> empty_waits_{0};
+
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+};
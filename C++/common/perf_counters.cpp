@@ -0,0 +1,150 @@
+#include "perf_counters.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const char* COUNTER_NAMES[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"
+};
+
+static perf_event_attr counter_attr(int id) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+
+    switch (id) {
+        case PERF_CYCLES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_INSTRUCTIONS:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_BRANCH_MISSES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PERF_L1D_MISSES:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case PERF_LLC_MISSES:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+    }
+
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Só o líder começa desligado; os outros seguem-no
+    attr.disabled = id == PERF_CYCLES;
+    return attr;
+}
+
+PerfCounters::PerfCounters() {
+    for (int& fd : fds_)
+        fd = -1;
+}
+
+PerfCounters::~PerfCounters() {
+    // Primeiro os membros do grupo, o líder no fim
+    for (int i = PERF_COUNTER_COUNT - 1; i >= 0; i--) {
+        if (fds_[i] >= 0)
+            close(fds_[i]);
+    }
+}
+
+int PerfCounters::open() {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        perf_event_attr attr = counter_attr(i);
+
+        // pid 0, cpu -1: esta thread, em qualquer CPU
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, fds_[PERF_CYCLES], 0));
+        std::uint64_t id = 0;
+        if (fd >= 0 && ioctl(fd, PERF_EVENT_IOC_ID, &id) != 0) {
+            close(fd);
+            fd = -1;
+        }
+
+        if (fd < 0) {
+            if (i == PERF_CYCLES) {
+                error_ = errno;
+                return 1;
+            }
+            continue; // p.ex. sem evento L1d nesta VM
+        }
+        fds_[i] = fd;
+        ids_[i] = id;
+    }
+    return 0;
+}
+
+void PerfCounters::start() {
+    ioctl(fds_[PERF_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[PERF_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+int PerfCounters::stop(PerfSample& sample) {
+    ioctl(fds_[PERF_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    sample = PerfSample{};
+
+    // nr, time_enabled, time_running e { value, id } por contador
+    std::uint64_t buffer[3 + 2 * PERF_COUNTER_COUNT];
+    ssize_t n = read(fds_[PERF_CYCLES], buffer, sizeof(buffer));
+    if (n < static_cast<ssize_t>(3 * sizeof(std::uint64_t)))
+        return 1;
+
+    std::uint64_t nr = buffer[0];
+    std::uint64_t enabled = buffer[1];
+    std::uint64_t running = buffer[2];
+    if (running == 0 || nr > PERF_COUNTER_COUNT)
+        return 1; // o grupo nunca esteve no PMU
+
+    for (std::uint64_t k = 0; k < nr; k++) {
+        std::uint64_t value = buffer[3 + 2 * k];
+        std::uint64_t id = buffer[4 + 2 * k];
+
+        // Escala se o grupo foi multiplexado com outros eventos
+        if (running < enabled)
+            value = static_cast<std::uint64_t>(double(value) * double(enabled) / double(running));
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            if (fds_[i] >= 0 && ids_[i] == id) {
+                sample.values[i] = value;
+                sample.present[i] = true;
+            }
+        }
+    }
+    return 0;
+}
+
+const char* perf_counter_name(int id) {
+    if (id < 0 || id >= PERF_COUNTER_COUNT)
+        return "unknown";
+    return COUNTER_NAMES[id];
+}
+
+void perf_counters_explain(int err) {
+    int paranoid = -1;
+    if (FILE* f = std::fopen("/proc/sys/kernel/perf_event_paranoid", "r")) {
+        if (std::fscanf(f, "%d", &paranoid) != 1)
+            paranoid = -1;
+        std::fclose(f);
+    }
+
+    std::fprintf(stderr, "Hardware counters unavailable: %s", std::strerror(err));
+    if (paranoid >= 0)
+        std::fprintf(stderr, " (kernel.perf_event_paranoid = %d%s)", paranoid,
+                     paranoid > 2 ? ", needs <= 2" : "");
+    std::fprintf(stderr, "; continuing without them\n");
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Contadores de hardware da thread atual, com perf_event_open.
+ *
+ * Todos os contadores são abertos como um grupo (cycles é o líder), por
+ * isso são sempre escalonados juntos e medem o mesmo intervalo. Só conta
+ * user space (exclude_kernel), que é o que perf_event_paranoid = 2 ainda
+ * permite a um utilizador normal.
+ *
+ * Contadores que o CPU (ou a VM) não tem são ignorados; se nem o de ciclos
+ * abrir, open() falha e o benchmark continua sem contadores.
+ */
+
+enum PerfCounterId {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_COUNTER_COUNT
+};
+
+struct PerfSample {
+    std::uint64_t values[PERF_COUNTER_COUNT] = {};
+    bool present[PERF_COUNTER_COUNT] = {}; // true se values[i] foi contado
+};
+
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /*
+     * Abre o grupo para a thread atual (desligado).
+     * Retorna 0 em sucesso, 1 se não houver contadores; nesse caso
+     * error() tem o errno do perf_event_open que falhou.
+     */
+    int open();
+
+    bool available() const { return fds_[PERF_CYCLES] >= 0; }
+    int error() const { return error_; }
+
+    // Reset + enable do grupo todo
+    void start();
+
+    /*
+     * Desliga o grupo e lê-o para "sample" (escalado se o grupo foi
+     * multiplexado). Retorna 0 em sucesso, 1 se nada foi contado.
+     */
+    int stop(PerfSample& sample);
+
+private:
+    int fds_[PERF_COUNTER_COUNT];
+    std::uint64_t ids_[PERF_COUNTER_COUNT] = {};
+    int error_ = 0;
+};
+
+/*
+ * Nome curto de um contador ("cycles", "llc_misses", ...).
+ */
+const char* perf_counter_name(int id);
+
+/*
+ * Escreve no stderr porque é que os contadores não estão disponíveis
+ * (errno e perf_event_paranoid).
+ */
+void perf_counters_explain(int err);
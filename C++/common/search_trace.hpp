@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Tracer da árvore de procura (opcional, para analisar tabuleiros
+ * patológicos offline com trace_decode.exe).
+ *
+ * Com -DSUDOKU_TRACE (make TRACE=1) cada solver regista um evento de 8 bytes
+ * por decisão num buffer por thread; quando o buffer enche (e no fim da
+ * thread) é escrito de uma vez no ficheiro $SUDOKU_TRACE_FILE
+ * (sudoku_trace.bin por omissão), em blocos com cabeçalho.
+ *
+ * Sem SUDOKU_TRACE as macros não geram código nem avaliam os argumentos,
+ * por isso solve_recursive fica exatamente igual.
+ */
+
+enum TraceOutcome : std::uint8_t {
+    TRACE_BEGIN = 0, // início de um solve: cell = pistas, value = solver
+    TRACE_TRY,       // valor colocado numa célula (desce um nível)
+    TRACE_FAIL,      // a subárvore desse valor falhou e foi desfeita (sobe)
+    TRACE_SOLVED     // solução encontrada
+};
+
+enum TraceEngine : std::uint8_t {
+    TRACE_UNOPTIMIZED,
+    TRACE_BITMASKING,
+    TRACE_BITMASKING_FC,
+    TRACE_DLX,
+    TRACE_HYBRID
+};
+
+struct TraceEvent {
+    std::uint8_t depth;      // nível da decisão (0 = primeira)
+    std::uint8_t cell;       // 0-80
+    std::uint8_t value;      // 1-9
+    std::uint8_t candidates; // valores válidos que ainda faltam tentar nesta célula
+    std::uint8_t outcome;    // TraceOutcome
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(TraceEvent) == 8, "TraceEvent must stay 8 bytes");
+
+/*
+ * Cabeçalho de cada bloco no ficheiro, seguido de "count" eventos.
+ * Os blocos de threads diferentes podem estar intercalados.
+ */
+struct TraceChunkHeader {
+    char magic[4];        // "STRC"
+    std::uint32_t thread; // número da thread (pela ordem do primeiro evento)
+    std::uint32_t count;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(TraceChunkHeader) == 16, "TraceChunkHeader must stay 16 bytes");
+
+#ifdef SUDOKU_TRACE
+
+#include <atomic>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace search_trace {
+
+static constexpr std::uint32_t RING_EVENTS = 1 << 16; // 512 KB por thread
+
+// Descritor partilhado, aberto (e truncado) no primeiro flush
+inline int trace_fd() {
+    static const int fd = [] {
+        const char* path = std::getenv("SUDOKU_TRACE_FILE");
+        return open(path ? path : "sudoku_trace.bin", O_WRONLY | O_CREAT | O_TRUNC | O_APPEND,
+                    0644);
+    }();
+    return fd;
+}
+
+inline std::atomic<std::uint32_t> next_thread{0};
+
+struct Ring {
+    TraceEvent* events = new TraceEvent[RING_EVENTS]; // no heap, não no TLS
+    std::uint32_t used = 0;
+    std::uint32_t thread = next_thread.fetch_add(1);
+    std::uint8_t depth = 0;
+
+    // Cabeçalho + eventos num só writev (O_APPEND: o bloco fica inteiro)
+    void flush() {
+        if (used == 0)
+            return;
+        int fd = trace_fd();
+        if (fd >= 0) {
+            TraceChunkHeader h = {{'S', 'T', 'R', 'C'}, thread, used, 0};
+            iovec iov[2] = {{&h, sizeof(h)}, {events, used * sizeof(TraceEvent)}};
+            ssize_t ignored = writev(fd, iov, 2);
+            (void)ignored;
+        }
+        used = 0;
+    }
+
+    ~Ring() {
+        flush();
+        delete[] events;
+    }
+
+    void push(int cell, int value, int candidates, TraceOutcome outcome) {
+        if (used == RING_EVENTS)
+            flush();
+        TraceEvent& e = events[used++];
+        e.depth = depth;
+        e.cell = static_cast<std::uint8_t>(cell);
+        e.value = static_cast<std::uint8_t>(value);
+        e.candidates = static_cast<std::uint8_t>(candidates);
+        e.outcome = outcome;
+        e.reserved[0] = e.reserved[1] = e.reserved[2] = 0;
+    }
+};
+
+inline Ring& ring() {
+    static thread_local Ring r;
+    return r;
+}
+
+inline void begin(TraceEngine engine, const std::uint8_t* cells) {
+    int clues = 0;
+    for (int i = 0; i < 81; i++)
+        clues += cells[i] != 0;
+    Ring& r = ring();
+    r.depth = 0;
+    r.push(clues, engine, 0, TRACE_BEGIN);
+}
+
+inline void try_value(int cell, int value, int candidates) {
+    Ring& r = ring();
+    r.push(cell, value, candidates, TRACE_TRY);
+    r.depth++;
+}
+
+inline void fail(int cell, int value) {
+    Ring& r = ring();
+    r.depth--;
+    r.push(cell, value, 0, TRACE_FAIL);
+}
+
+inline void solved() {
+    ring().push(0, 0, 0, TRACE_SOLVED);
+}
+
+} // namespace search_trace
+
+#define SUDOKU_TRACE_BEGIN(engine, cells) search_trace::begin(engine, cells)
+#define SUDOKU_TRACE_TRY(cell, value, candidates) search_trace::try_value(cell, value, candidates)
+#define SUDOKU_TRACE_FAIL(cell, value) search_trace::fail(cell, value)
+#define SUDOKU_TRACE_SOLVED() search_trace::solved()
+
+#else
+
+#define SUDOKU_TRACE_BEGIN(engine, cells) ((void)0)
+#define SUDOKU_TRACE_TRY(cell, value, candidates) ((void)0)
+#define SUDOKU_TRACE_FAIL(cell, value) ((void)0)
+#define SUDOKU_TRACE_SOLVED() ((void)0)
+
+#endif
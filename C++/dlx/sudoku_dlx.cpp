@@ -1,9 +1,9 @@
 #include "sudoku_dlx.hpp"
+#include "sudoku_dlx_internal.hpp"
 #include "../common/board.hpp"
+#include "../common/search_trace.hpp"
 
-#include <fstream>
 #include <cstdint>
-#include <iostream>
 
 // --------------------------------------------------
 // Configuração DLX
@@ -27,13 +27,13 @@ struct Column {
 
 // --------------------------------------------------
 
-static Node nodes[MAX_NODES];
-static Column columns[COLS];
-static int node_count;
-static int root;
+static thread_local Node nodes[MAX_NODES];
+static thread_local Column columns[COLS];
+static thread_local int node_count;
+static thread_local int root;
 
-static int solution_rows[81];
-static int solution_size;
+static thread_local int solution_rows[81];
+static thread_local int solution_size;
 
 // --------------------------------------------------
 
@@ -100,9 +100,21 @@ static int choose_column() {
 
 // --------------------------------------------------
 
+#ifdef SUDOKU_TRACE
+// Linhas da coluna que ainda faltam tentar depois de r
+static int rows_below(int r, int col_head) {
+    int n = 0;
+    for (r = nodes[r].D; r != col_head; r = nodes[r].D)
+        n++;
+    return n;
+}
+#endif
+
 static bool search() {
-    if (nodes[root].R == root)
+    if (nodes[root].R == root) {
+        SUDOKU_TRACE_SOLVED();
         return true;
+    }
 
     int c = choose_column();
     if (c < 0 || columns[c].size == 0)
@@ -116,6 +128,8 @@ static bool search() {
 
         for (int n = nodes[r].R; n != r; n = nodes[n].R)
             cover(nodes[n].C);
+        // row_id = linha*81 + coluna*9 + valor: célula = row_id / 9
+        SUDOKU_TRACE_TRY(nodes[r].row_id / 9, nodes[r].row_id % 9 + 1, rows_below(r, col_head));
 
         if (search())
             return true;
@@ -124,6 +138,7 @@ static bool search() {
             uncover(nodes[n].C);
 
         solution_size--;
+        SUDOKU_TRACE_FAIL(nodes[r].row_id / 9, nodes[r].row_id % 9 + 1);
     }
 
     uncover(c);
@@ -198,9 +213,9 @@ static inline int col_box(int b, int v)  { return 243 + b * 9 + v; }
 // --------------------------------------------------
 // Solver
 
-int solve(const Board& input, Board& solution) {
+// Uma linha por pista, nove por célula vazia
+static void build(const Board& input) {
     init_dlx();
-    solution = input;
 
     for (int r = 0; r < 9; r++) {
         for (int c = 0; c < 9; c++) {
@@ -231,6 +246,12 @@ int solve(const Board& input, Board& solution) {
             }
         }
     }
+}
+
+int solve_dlx(const Board& input, Board& solution) {
+    build(input);
+    solution = input;
+    SUDOKU_TRACE_BEGIN(TRACE_DLX, input.cells.data());
 
     if (!search())
         return 0;
@@ -250,26 +271,40 @@ int solve(const Board& input, Board& solution) {
 }
 
 // --------------------------------------------------
-// File IO
-
-int read_file(Board& board, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open())
-        return 1;
-
-    int idx = 0;
-    char c;
-    while (idx < 81 && file.get(c)) {
-        if (c >= '0' && c <= '9')
-            board.cells[idx++] = static_cast<uint8_t>(c - '0');
+// Primitivas para os microbenchmarks (sudoku_dlx_internal.hpp)
+
+namespace dlx_internal {
+
+void load(const Board& board) {
+    build(board);
+
+    // A coluna de uma célula preenchida só tem a linha da pista
+    for (int idx = 0; idx < 81; idx++) {
+        if (board.cells[idx] == 0)
+            continue;
+
+        int col_head = columns[col_cell(idx / 9, idx % 9)].head;
+        int r = nodes[col_head].D;
+        ::cover(nodes[r].C);
+        for (int n = nodes[r].R; n != r; n = nodes[n].R)
+            ::cover(nodes[n].C);
     }
-    return idx == 81 ? 0 : 1;
 }
 
-void print_board(const Board& board) {
-    for (int r = 0; r < 9; r++) {
-        for (int c = 0; c < 9; c++)
-            std::cout << int(board.cells[r * 9 + c]);
-        std::cout << "\n";
-    }
+int choose_column() {
+    return ::choose_column();
+}
+
+int column_size(int c) {
+    return columns[c].size;
 }
+
+void cover(int c) {
+    ::cover(c);
+}
+
+void uncover(int c) {
+    ::uncover(c);
+}
+
+} // namespace dlx_internal
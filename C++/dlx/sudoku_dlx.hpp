@@ -5,6 +5,11 @@
 #include <string>
 #include "../common/board.hpp"
 
+/*
+ * read_file, solve e print_board estão em sudoku_dlx_generic.cpp: só os
+ * executáveis com este solver sozinho ligam esse objeto.
+ */
+
 /*
  * Lê um tabuleiro de um ficheiro.
  * Preenche "board".
@@ -20,6 +25,12 @@ int read_file(Board& board, const std::string& filename);
  */
 int solve(const Board& input, Board& solution);
 
+/*
+ * O mesmo solve, com um nome próprio deste solver
+ * (para ligar vários solvers no mesmo executável).
+ */
+int solve_dlx(const Board& input, Board& solution);
+
 /*
  * Imprime o tabuleiro como 9 linhas de 9 dígitos.
  */
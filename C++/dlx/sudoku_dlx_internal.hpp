@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../common/board.hpp"
+
+/*
+ * Primitivas internas do solver DLX, expostas só para os microbenchmarks
+ * (microbench.cpp). Não fazem parte da API: trabalham sobre a matriz
+ * thread_local do solver, tal como search.
+ */
+namespace dlx_internal {
+
+/*
+ * Constrói a matriz do tabuleiro e escolhe a linha de cada célula
+ * preenchida, como o search faria: um tabuleiro parcial dá o estado da
+ * procura com essas células colocadas.
+ */
+void load(const Board& board);
+
+// Coluna com menos linhas (-1 se já não há colunas)
+int choose_column();
+
+// Número de linhas da coluna c
+int column_size(int c);
+
+void cover(int c);
+void uncover(int c);
+
+} // namespace dlx_internal
@@ -0,0 +1,378 @@
+#include "dlx/sudoku_dlx.hpp"
+#include "common/board_writer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Gerador de corpus: N puzzles com solução única, reprodutíveis a partir
+// de uma seed, num ficheiro de linhas (81 dígitos, '0' = vazio).
+//
+// Tiers:
+//   easy    : remove pistas até ficarem entre 36 e 45 (solução única);
+//   minimal : remove pistas até nenhuma poder sair sem perder a unicidade
+//             (puzzles irredutíveis, normalmente 20-26 pistas);
+//   hard    : puzzles minimal que precisam de pelo menos --min-backtracks
+//             nós (1000 por omissão) numa procura MRV sem propagação.
+//
+// Puzzles de 17 pistas não aparecem ao remover pistas ao acaso (são
+// raríssimos); o tier minimal é o equivalente que se gera em tempo útil.
+//
+// Cada puzzle i usa o seu próprio gerador (seed, tier, i), por isso o
+// resultado não depende do número de threads. No fim, cada puzzle é
+// resolvido com o solver DLX (exato), que tem de encontrar a solução.
+//
+// Uso: ./generate_corpus.exe --tier easy|minimal|hard [--count N] [--seed S]
+//                            [--threads T] [--min-backtracks B] [ficheiro|-]
+
+using Clock = std::chrono::steady_clock;
+
+enum class Tier { EASY, MINIMAL, HARD };
+
+struct Options {
+    Tier tier = Tier::EASY;
+    std::size_t count = 10000;
+    std::uint64_t seed = 1;
+    unsigned threads = 0;
+    std::uint64_t min_backtracks = 1000;
+    const char* out_path = nullptr;
+};
+
+// --------------------------------------------------
+// Gerador pseudo-aleatório (splitmix64): igual em qualquer compilador,
+// ao contrário das distribuições de <random>.
+
+struct Rng {
+    std::uint64_t state;
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Inteiro em [0, n) (multiplicação em vez de %, sem divisões)
+    unsigned below(unsigned n) {
+        return static_cast<unsigned>(((next() >> 32) * n) >> 32);
+    }
+};
+
+template <typename T, std::size_t N>
+static void shuffle(T (&values)[N], Rng& rng) {
+    for (std::size_t i = N - 1; i > 0; i--) {
+        unsigned j = rng.below(static_cast<unsigned>(i + 1));
+        T tmp = values[i];
+        values[i] = values[j];
+        values[j] = tmp;
+    }
+}
+
+// --------------------------------------------------
+// Procura com bitmasks e MRV, sem propagação: conta soluções (até "limit")
+// e nós, ou preenche uma grelha vazia com dígitos por ordem aleatória.
+
+static constexpr std::uint16_t ALL_DIGITS = 0x3FE; // bits 1..9
+
+struct Search {
+    std::uint8_t cells[81];
+    std::uint16_t rows[9] = {};
+    std::uint16_t cols[9] = {};
+    std::uint16_t boxes[9] = {};
+
+    int solutions = 0;
+    int limit = 2;
+    std::uint64_t nodes = 0;
+    Rng* rng = nullptr; // != nullptr: escolhe os dígitos por ordem aleatória
+
+    static int box_of(int i) { return (i / 27) * 3 + (i % 9) / 3; }
+
+    // false se as pistas já estiverem em conflito
+    bool init(const Board& board) {
+        for (int i = 0; i < 81; i++) {
+            cells[i] = board.cells[i];
+            if (cells[i] == 0)
+                continue;
+            std::uint16_t bit = static_cast<std::uint16_t>(1u << cells[i]);
+            if ((rows[i / 9] | cols[i % 9] | boxes[box_of(i)]) & bit)
+                return false;
+            rows[i / 9] |= bit;
+            cols[i % 9] |= bit;
+            boxes[box_of(i)] |= bit;
+        }
+        return true;
+    }
+
+    void set(int i, int d) {
+        std::uint16_t bit = static_cast<std::uint16_t>(1u << d);
+        cells[i] = static_cast<std::uint8_t>(d);
+        rows[i / 9] ^= bit;
+        cols[i % 9] ^= bit;
+        boxes[box_of(i)] ^= bit;
+    }
+
+    // Retorna true quando deve parar (limite de soluções atingido)
+    bool run() {
+        int best = -1;
+        int best_count = 10;
+        std::uint16_t best_mask = 0;
+
+        for (int i = 0; i < 81; i++) {
+            if (cells[i] != 0)
+                continue;
+            std::uint16_t mask = ALL_DIGITS & ~(rows[i / 9] | cols[i % 9] | boxes[box_of(i)]);
+            int count = __builtin_popcount(mask);
+            if (count < best_count) {
+                best = i;
+                best_count = count;
+                best_mask = mask;
+                if (count <= 1)
+                    break;
+            }
+        }
+
+        if (best < 0)
+            return ++solutions >= limit;
+        if (best_count == 0)
+            return false;
+
+        int digits[9];
+        int n = 0;
+        for (int d = 1; d <= 9; d++) {
+            if (best_mask & (1u << d))
+                digits[n++] = d;
+        }
+        if (rng) {
+            for (int k = n - 1; k > 0; k--) {
+                int j = static_cast<int>(rng->below(static_cast<unsigned>(k + 1)));
+                int tmp = digits[k];
+                digits[k] = digits[j];
+                digits[j] = tmp;
+            }
+        }
+
+        for (int k = 0; k < n; k++) {
+            nodes++;
+            set(best, digits[k]);
+            bool stop = run();
+            if (stop && rng)
+                return true; // preenchimento: fica com a grelha
+            set(best, digits[k]);
+            cells[best] = 0;
+            if (stop)
+                return true;
+        }
+        return false;
+    }
+};
+
+// Número de soluções (0, 1 ou 2 = "mais de uma") e nós da procura
+static int count_solutions(const Board& board, std::uint64_t* nodes = nullptr) {
+    Search s;
+    if (!s.init(board))
+        return 0;
+    s.run();
+    if (nodes)
+        *nodes = s.nodes;
+    return s.solutions;
+}
+
+static Board random_grid(Rng& rng) {
+    Search s;
+    Board empty{};
+    s.init(empty);
+    s.limit = 1;
+    s.rng = &rng;
+    s.run();
+
+    Board grid;
+    std::memcpy(grid.cells.data(), s.cells, 81);
+    return grid;
+}
+
+// Remove pistas por ordem aleatória enquanto a solução continuar única,
+// até ficarem "target" (0 = até não dar para tirar mais nenhuma)
+static Board reduce(const Board& grid, int target, Rng& rng) {
+    Board puzzle = grid;
+    int order[81];
+    for (int i = 0; i < 81; i++)
+        order[i] = i;
+    shuffle(order, rng);
+
+    int clues = 81;
+    for (int i : order) {
+        if (clues <= target)
+            break;
+
+        std::uint8_t v = puzzle.cells[i];
+        puzzle.cells[i] = 0;
+        if (count_solutions(puzzle) == 1)
+            clues--;
+        else
+            puzzle.cells[i] = v;
+    }
+    return puzzle;
+}
+
+// --------------------------------------------------
+
+static const char* tier_name(Tier t) {
+    switch (t) {
+        case Tier::EASY:    return "easy";
+        case Tier::MINIMAL: return "minimal";
+        case Tier::HARD:    return "hard";
+    }
+    return "unknown";
+}
+
+// Puzzle "index" do tier; "attempts" conta as grelhas geradas
+static Board generate(const Options& opt, std::size_t index, std::uint64_t& attempts) {
+    Rng rng{opt.seed * 0x2545F4914F6CDD1DULL ^ (std::uint64_t(opt.tier) << 56) ^ index};
+
+    for (;;) {
+        attempts++;
+        Board grid = random_grid(rng);
+
+        if (opt.tier == Tier::EASY)
+            return reduce(grid, 36 + static_cast<int>(rng.below(10)), rng);
+
+        Board puzzle = reduce(grid, 0, rng);
+        if (opt.tier == Tier::MINIMAL)
+            return puzzle;
+
+        std::uint64_t nodes = 0;
+        count_solutions(puzzle, &nodes);
+        if (nodes >= opt.min_backtracks)
+            return puzzle;
+    }
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    int i = 1;
+    for (; i < argc && std::strncmp(argv[i], "--", 2) == 0; i++) {
+        if (i + 1 >= argc)
+            return false;
+
+        const char* arg = argv[i];
+        const char* val = argv[++i];
+
+        if (std::strcmp(arg, "--tier") == 0) {
+            if (std::strcmp(val, "easy") == 0)
+                opt.tier = Tier::EASY;
+            else if (std::strcmp(val, "minimal") == 0)
+                opt.tier = Tier::MINIMAL;
+            else if (std::strcmp(val, "hard") == 0)
+                opt.tier = Tier::HARD;
+            else
+                return false;
+        } else if (std::strcmp(arg, "--count") == 0) {
+            opt.count = static_cast<std::size_t>(std::atol(val));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            opt.seed = std::strtoull(val, nullptr, 10);
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            opt.threads = static_cast<unsigned>(std::atoi(val));
+        } else if (std::strcmp(arg, "--min-backtracks") == 0) {
+            opt.min_backtracks = std::strtoull(val, nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+
+    if (i < argc)
+        opt.out_path = argv[i++];
+    if (i < argc)
+        return false;
+
+    if (opt.threads == 0)
+        opt.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s --tier easy|minimal|hard [--count N] [--seed S] [--threads T]\n"
+                     "          [--min-backtracks B] [output_file|-]\n", argv[0]);
+        return 1;
+    }
+
+    auto start = Clock::now();
+
+    std::vector<Board> puzzles(opt.count);
+    std::vector<std::uint64_t> attempts(opt.threads, 0);
+    std::vector<std::size_t> failures(opt.threads, 0);
+    std::vector<std::thread> workers;
+
+    for (unsigned t = 0; t < opt.threads; t++) {
+        workers.emplace_back([&, t] {
+            std::uint64_t tried = 0;
+            std::size_t failed = 0;
+
+            for (std::size_t i = t; i < opt.count; i += opt.threads) {
+                Board solution;
+                puzzles[i] = generate(opt, i, tried);
+
+                // O solver tem de encontrar a (única) solução
+                if (solve(puzzles[i], solution) != 1 || count_solutions(puzzles[i]) != 1)
+                    failed++;
+            }
+            attempts[t] = tried;
+            failures[t] = failed;
+        });
+    }
+    for (std::thread& w : workers)
+        w.join();
+
+    std::uint64_t total_attempts = 0;
+    std::size_t total_failures = 0;
+    std::size_t total_clues = 0;
+    for (unsigned t = 0; t < opt.threads; t++) {
+        total_attempts += attempts[t];
+        total_failures += failures[t];
+    }
+    for (const Board& b : puzzles) {
+        for (std::uint8_t v : b.cells)
+            total_clues += v != 0;
+    }
+
+    int out_fd = STDOUT_FILENO;
+    if (opt.out_path && std::strcmp(opt.out_path, "-") != 0) {
+        out_fd = open(opt.out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out_fd < 0) {
+            std::fprintf(stderr, "Error opening output: %s\n", opt.out_path);
+            return 1;
+        }
+    }
+
+    int write_err;
+    {
+        BoardWriter writer(out_fd);
+        for (const Board& b : puzzles)
+            writer.write_board(b);
+        write_err = writer.flush();
+    }
+    if (out_fd != STDOUT_FILENO)
+        close(out_fd);
+
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    std::fprintf(stderr, "Tier %s: %zu puzzles (seed %llu), %.1f clues on average, "
+                 "%llu grids tried, %.1f s\n",
+                 tier_name(opt.tier), opt.count, static_cast<unsigned long long>(opt.seed),
+                 opt.count ? double(total_clues) / double(opt.count) : 0.0,
+                 static_cast<unsigned long long>(total_attempts), secs);
+
+    if (total_failures != 0) {
+        std::fprintf(stderr, "Error: %zu puzzles not solved by the solver\n", total_failures);
+        return 1;
+    }
+    return write_err;
+}
@@ -0,0 +1,57 @@
+#include "common/latency_histogram.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+// --------------------------------------------------
+// Relatório de histogramas guardados com --hist (batch, pipeline, benchmark).
+//
+// Mostra cada ficheiro e, com mais de um, todos juntos (os histogramas do
+// mesmo solver e classe são somados, p.ex. corridas em máquinas diferentes
+// ou em dias diferentes, para comparar ou para juntar).
+//
+// Uso: ./hist_report.exe [--csv ficheiro|-] <ficheiro.hist>...
+// Com --csv, o resultado junto é escrito bucket a bucket.
+
+int main(int argc, char* argv[]) {
+    const char* csv_path = nullptr;
+    int arg = 1;
+
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--csv") == 0) {
+        csv_path = argv[arg + 1];
+        arg += 2;
+    }
+
+    if (arg >= argc) {
+        std::fprintf(stderr, "Usage: %s [--csv file|-] <file.hist>...\n", argv[0]);
+        return 1;
+    }
+
+    // Com o CSV no stdout, as tabelas vão para o stderr
+    FILE* out = csv_path && std::strcmp(csv_path, "-") == 0 ? stderr : stdout;
+    LatencyReport merged;
+
+    for (int i = arg; i < argc; i++) {
+        LatencyReport report;
+        if (report.load(argv[i]) != 0) {
+            std::fprintf(stderr, "Error reading histogram: %s\n", argv[i]);
+            return 1;
+        }
+
+        std::fprintf(out, "== %s\n", argv[i]);
+        report.print(out);
+        std::fprintf(out, "\n");
+        merged.merge(report);
+    }
+
+    if (argc - arg > 1) {
+        std::fprintf(out, "== merged (%d files)\n", argc - arg);
+        merged.print(out);
+    }
+
+    if (csv_path && merged.write_csv(csv_path) != 0) {
+        std::fprintf(stderr, "Error writing %s\n", csv_path);
+        return 1;
+    }
+    return 0;
+}
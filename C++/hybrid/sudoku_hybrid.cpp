@@ -1,8 +1,9 @@
 #include "sudoku_hybrid.hpp"
+#include "sudoku_hybrid_internal.hpp"
 #include "../common/board.hpp"
+#include "../common/search_trace.hpp"
+#include "../common/cpu_dispatch.hpp"
 
-#include <fstream>
-#include <iostream>
 #include <cstdint>
 #include <vector>
 #include <algorithm>
@@ -26,14 +27,16 @@ static inline int lsb_index(uint16_t x) {
 
 // -------------------------------------
 
-static uint16_t row_mask[9];
-static uint16_t col_mask[9];
-static uint16_t box_mask[9];
+static thread_local uint16_t row_mask[9];
+static thread_local uint16_t col_mask[9];
+static thread_local uint16_t box_mask[9];
 
 // -------------------------------------
 // Constraint Propagation
+// (sempre inlined em solve_recursive, mesmo com a cópia para os
+// microbenchmarks no fim do ficheiro)
 
-static bool apply_logic(Board& board) {
+static inline __attribute__((always_inline)) bool apply_logic(Board& board) {
     bool progress = true;
 
     while (progress) {
@@ -108,12 +111,12 @@ static bool apply_logic(Board& board) {
 }
 
 // -------------------------------------
-// MRV + LCV
+// MRV + LCV (always_inline: compilada dentro de cada versão de solve_recursive)
 
-static bool find_best_cell(const Board& board,
-                           int& out_r,
-                           int& out_c,
-                           std::vector<int>& ordered_values) {
+static inline __attribute__((always_inline)) bool find_best_cell(const Board& board,
+                                                                 int& out_r,
+                                                                 int& out_c,
+                                                                 std::vector<int>& ordered_values) {
     int min_count = 10;
     bool found = false;
 
@@ -175,17 +178,19 @@ static bool find_best_cell(const Board& board,
 }
 
 // -------------------------------------
-// Backtracking
+// Backtracking, uma versão por nível de CPU (common/cpu_dispatch.hpp)
 
-static bool solve_recursive(Board& board) {
+SUDOKU_DISPATCH static bool solve_recursive(Board& board) {
     if (!apply_logic(board))
         return false;
 
     int r, c;
     std::vector<int> values;
 
-    if (!find_best_cell(board, r, c, values))
+    if (!find_best_cell(board, r, c, values)) {
+        SUDOKU_TRACE_SOLVED();
         return true;
+    }
 
     int idx = r * 9 + c;
     int b = box_index(r, c);
@@ -197,6 +202,8 @@ static bool solve_recursive(Board& board) {
         row_mask[r] |= bit;
         col_mask[c] |= bit;
         box_mask[b] |= bit;
+        SUDOKU_TRACE_TRY(idx, v + 1,
+                         values.end() - std::find(values.begin(), values.end(), v) - 1);
 
         if (solve_recursive(board))
             return true;
@@ -205,6 +212,7 @@ static bool solve_recursive(Board& board) {
         row_mask[r] ^= bit;
         col_mask[c] ^= bit;
         box_mask[b] ^= bit;
+        SUDOKU_TRACE_FAIL(idx, v + 1);
     }
 
     return false;
@@ -213,9 +221,7 @@ static bool solve_recursive(Board& board) {
 // -------------------------------------
 // API
 
-int solve(const Board& input, Board& solution) {
-    solution = input;
-
+static void load_masks(const Board& board) {
     for (int i = 0; i < 9; i++) {
         row_mask[i] = col_mask[i] = box_mask[i] = 0;
     }
@@ -223,7 +229,7 @@ int solve(const Board& input, Board& solution) {
     for (int r = 0; r < 9; r++) {
         for (int c = 0; c < 9; c++) {
             int idx = r * 9 + c;
-            int v = solution.cells[idx];
+            int v = board.cells[idx];
             if (v != 0) {
                 uint16_t bit = 1 << (v - 1);
                 row_mask[r] |= bit;
@@ -232,32 +238,29 @@ int solve(const Board& input, Board& solution) {
             }
         }
     }
+}
+
+int solve_hybrid(const Board& input, Board& solution) {
+    solution = input;
+    SUDOKU_TRACE_BEGIN(TRACE_HYBRID, input.cells.data());
+
+    load_masks(solution);
 
     return solve_recursive(solution) ? 1 : 0;
 }
 
 // -------------------------------------
-// IO
-
-int read_file(Board& board, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open())
-        return 1;
-
-    int idx = 0;
-    char c;
-    while (idx < 81 && file.get(c)) {
-        if (c >= '0' && c <= '9')
-            board.cells[idx++] = static_cast<uint8_t>(c - '0');
-    }
+// Primitivas para os microbenchmarks (sudoku_hybrid_internal.hpp), com o
+// mesmo despacho que solve_recursive
+
+namespace hybrid_internal {
 
-    return idx == 81 ? 0 : 1;
+void load(const Board& board) {
+    load_masks(board);
 }
 
-void print_board(const Board& board) {
-    for (int r = 0; r < 9; r++) {
-        for (int c = 0; c < 9; c++)
-            std::cout << int(board.cells[r * 9 + c]);
-        std::cout << "\n";
-    }
+SUDOKU_DISPATCH bool apply_logic(Board& board) {
+    return ::apply_logic(board);
 }
+
+} // namespace hybrid_internal
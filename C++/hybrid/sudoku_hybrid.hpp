@@ -3,6 +3,14 @@
 #include <string>
 #include "../common/board.hpp"
 
+// read_file, solve e print_board estão em sudoku_hybrid_generic.cpp: só os
+// executáveis com este solver sozinho ligam esse objeto.
 int read_file(Board& board, const std::string& filename);
 int solve(const Board& input, Board& solution);
+
+/*
+ * O mesmo solve, com um nome próprio deste solver
+ * (para ligar vários solvers no mesmo executável).
+ */
+int solve_hybrid(const Board& input, Board& solution);
 void print_board(const Board& board);
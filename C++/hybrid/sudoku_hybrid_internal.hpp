@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../common/board.hpp"
+
+/*
+ * Primitivas internas do solver híbrido, expostas só para os
+ * microbenchmarks (microbench.cpp). Não fazem parte da API: trabalham
+ * sobre as máscaras thread_local do solver.
+ */
+namespace hybrid_internal {
+
+// Carrega as máscaras a partir de um tabuleiro (possivelmente parcial)
+void load(const Board& board);
+
+/*
+ * Naked e hidden singles até não haver progresso; preenche "board".
+ * false se encontrou uma contradição.
+ */
+bool apply_logic(Board& board);
+
+} // namespace hybrid_internal
@@ -0,0 +1,150 @@
+#include "libsudoku.h"
+#include "libsudoku_c.h"
+
+#include <cstring>
+#include <new>
+
+#include "../common/engines.hpp"
+
+// --------------------------------------------------
+// Handle: o solver escolhido e os tabuleiros de trabalho da thread.
+// (o estado da procura de cada solver já é thread_local ou local)
+
+struct sudoku_solver {
+    const char* name;
+    const Engine* engine; // solver C++, ou nullptr
+    sudoku_cells_fn c_solve; // solver C, ou nullptr
+    Board input;
+    Board output;
+};
+
+static int cpp_count() {
+    return static_cast<int>(engine_count());
+}
+
+// --------------------------------------------------
+// Validação (as mesmas regras que clues_consistent em benchmark.cpp)
+
+static bool board_valid(const std::uint8_t* cells) {
+    std::uint16_t row[9] = {};
+    std::uint16_t col[9] = {};
+    std::uint16_t box[9] = {};
+
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            int v = cells[r * 9 + c];
+            if (v == 0)
+                continue;
+            if (v > 9)
+                return false;
+
+            std::uint16_t bit = static_cast<std::uint16_t>(1u << v);
+            int b = (r / 3) * 3 + (c / 3);
+            if ((row[r] | col[c] | box[b]) & bit)
+                return false;
+            row[r] |= bit;
+            col[c] |= bit;
+            box[b] |= bit;
+        }
+    }
+    return true;
+}
+
+static int solve_one(sudoku_solver* s, const std::uint8_t* puzzle, std::uint8_t* solution) {
+    // memmove: "solution" pode ser o próprio "puzzle"
+    if (!board_valid(puzzle)) {
+        std::memmove(solution, puzzle, 81);
+        return SUDOKU_INVALID;
+    }
+
+    int found;
+    if (s->engine) {
+        std::memcpy(s->input.cells.data(), puzzle, 81);
+        found = s->engine->solve(s->input, s->output);
+        std::memmove(solution, found ? s->output.cells.data() : puzzle, 81);
+    } else {
+        found = s->c_solve(puzzle, solution);
+        if (!found)
+            std::memmove(solution, puzzle, 81);
+    }
+    return found ? SUDOKU_SOLVED : SUDOKU_NO_SOLUTION;
+}
+
+// --------------------------------------------------
+// API
+
+extern "C" {
+
+int sudoku_abi_version(void) {
+    return SUDOKU_ABI_VERSION;
+}
+
+int sudoku_engine_count(void) {
+    return cpp_count() + sudoku_c_engine_count;
+}
+
+const char* sudoku_engine_name(int index) {
+    if (index < 0 || index >= sudoku_engine_count())
+        return nullptr;
+    if (index < cpp_count())
+        return engines_begin()[index].name;
+    return sudoku_c_engines[index - cpp_count()].name;
+}
+
+int sudoku_engine_find(const char* name) {
+    if (!name)
+        return -1;
+    for (int i = 0; i < sudoku_engine_count(); i++) {
+        if (std::strcmp(sudoku_engine_name(i), name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+sudoku_solver* sudoku_solver_create(const char* name) {
+    int index = sudoku_engine_find(name);
+    if (index < 0)
+        return nullptr;
+
+    sudoku_solver* s = new (std::nothrow) sudoku_solver{};
+    if (!s)
+        return nullptr;
+
+    s->name = sudoku_engine_name(index);
+    if (index < cpp_count())
+        s->engine = &engines_begin()[index];
+    else
+        s->c_solve = sudoku_c_engines[index - cpp_count()].solve;
+    return s;
+}
+
+void sudoku_solver_destroy(sudoku_solver* solver) {
+    delete solver;
+}
+
+const char* sudoku_solver_engine(const sudoku_solver* solver) {
+    return solver ? solver->name : nullptr;
+}
+
+int sudoku_solve(sudoku_solver* solver, const std::uint8_t puzzle[81], std::uint8_t solution[81]) {
+    if (!solver || !puzzle || !solution)
+        return SUDOKU_BAD_ARGUMENT;
+    return solve_one(solver, puzzle, solution);
+}
+
+std::size_t sudoku_solve_batch(sudoku_solver* solver, const std::uint8_t* puzzles,
+                               std::uint8_t* solutions, std::size_t count, std::int8_t* status) {
+    if (!solver || ((!puzzles || !solutions) && count > 0))
+        return 0;
+
+    std::size_t solved = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        int rc = solve_one(solver, puzzles + i * 81, solutions + i * 81);
+        solved += rc == SUDOKU_SOLVED;
+        if (status)
+            status[i] = static_cast<std::int8_t>(rc);
+    }
+    return solved;
+}
+
+} // extern "C"
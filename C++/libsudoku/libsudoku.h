@@ -0,0 +1,87 @@
+#ifndef LIBSUDOKU_H
+#define LIBSUDOKU_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * libsudoku: todos os solvers (C++ e os do diretório C) atrás de uma ABI C
+ * estável, para usar no mesmo processo (benchmarks, outras linguagens)
+ * em vez de lançar um executável por solver.
+ *
+ * Tabuleiros: 81 bytes, linha a linha, 0 = célula vazia.
+ *
+ * Um sudoku_solver é o estado de uma thread: cada thread cria o seu (é
+ * barato) e não o partilha. Threads diferentes podem resolver ao mesmo
+ * tempo, mesmo com o mesmo solver.
+ *
+ * Compilar contra libsudoku.a a partir de C precisa também de -lstdc++.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUDOKU_API __attribute__((visibility("default")))
+
+// Muda quando a ABI muda de forma incompatível
+#define SUDOKU_ABI_VERSION 1
+
+// Resultado de um solve (1/0 como os solvers)
+enum {
+    SUDOKU_SOLVED = 1,
+    SUDOKU_NO_SOLUTION = 0,
+    SUDOKU_INVALID = -1,     // células fora de 0-9 ou pistas em conflito
+    SUDOKU_BAD_ARGUMENT = -2 // handle ou ponteiro nulo
+};
+
+typedef struct sudoku_solver sudoku_solver;
+
+// SUDOKU_ABI_VERSION com que a biblioteca foi compilada
+SUDOKU_API int sudoku_abi_version(void);
+
+/*
+ * Solvers disponíveis, índices 0 .. sudoku_engine_count() - 1:
+ * primeiro os C++ (unoptimized, bitmasking, bitmasking_fc, dlx, hybrid),
+ * depois os C (c_v0 ... c_v5, c_unoptimized, c_v6, c_v3_sse).
+ * sudoku_engine_name retorna NULL fora do intervalo.
+ */
+SUDOKU_API int sudoku_engine_count(void);
+SUDOKU_API const char* sudoku_engine_name(int index);
+
+// Índice do solver com este nome, -1 se não existe
+SUDOKU_API int sudoku_engine_find(const char* name);
+
+/*
+ * Cria um handle para o solver "name". Retorna NULL se o nome não existe
+ * ou se falta memória. Libertar com sudoku_solver_destroy.
+ */
+SUDOKU_API sudoku_solver* sudoku_solver_create(const char* name);
+SUDOKU_API void sudoku_solver_destroy(sudoku_solver* solver);
+
+// Nome do solver do handle
+SUDOKU_API const char* sudoku_solver_engine(const sudoku_solver* solver);
+
+/*
+ * Resolve um tabuleiro. "solution" recebe a solução; sem solução ou com
+ * um tabuleiro inválido recebe uma cópia de "puzzle". Pode ser o mesmo
+ * array que "puzzle".
+ * Retorna SUDOKU_SOLVED, SUDOKU_NO_SOLUTION, SUDOKU_INVALID ou
+ * SUDOKU_BAD_ARGUMENT.
+ */
+SUDOKU_API int sudoku_solve(sudoku_solver* solver, const uint8_t puzzle[81],
+                            uint8_t solution[81]);
+
+/*
+ * Resolve "count" tabuleiros seguidos (81 * count bytes em cada array).
+ * "status" é opcional (NULL ou "count" entradas, o resultado de cada um).
+ * Retorna quantos foram resolvidos.
+ */
+SUDOKU_API size_t sudoku_solve_batch(sudoku_solver* solver, const uint8_t* puzzles,
+                                     uint8_t* solutions, size_t count, int8_t* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBSUDOKU_H
@@ -0,0 +1,62 @@
+#include "libsudoku_c.h"
+
+#include <string.h>
+
+#include "../../C/sudoku.h"
+#include "../../C/sudoku_unoptimized.h"
+#include "../../C/sudoku_optimized_v0.h"
+#include "../../C/sudoku_optimized_v1.h"
+#include "../../C/sudoku_optimized_v2.h"
+#include "../../C/sudoku_optimized_v3.h"
+#include "../../C/sudoku_optimized_v4.h"
+#include "../../C/sudoku_optimized_v5.h"
+#include "../../C/sudoku_optimized_v6.h"
+#include "../../C/sudoku_optimized_v3_sse.h"
+
+// Adaptador para os solvers com struct Board ("solution" só muda se resolveu)
+#define BOARD_ADAPTER(name, solver)                                   \
+    static int name(const uint8_t* puzzle, uint8_t* solution) {       \
+        struct Board in, out;                                         \
+        memcpy(in.cells, puzzle, 81);                                 \
+        int found = solver(&in, &out);                                \
+        if (found)                                                    \
+            memcpy(solution, out.cells, 81);                          \
+        return found;                                                 \
+    }
+
+BOARD_ADAPTER(solve_c_v0, solve_optimized_v0)
+BOARD_ADAPTER(solve_c_v1, solve_optimized_v1)
+BOARD_ADAPTER(solve_c_v2, solve_optimized_v2)
+BOARD_ADAPTER(solve_c_v4, solve_optimized_v4)
+BOARD_ADAPTER(solve_c_v5, solve_optimized_v5)
+BOARD_ADAPTER(solve_c_v6, solve_optimized_v6)
+BOARD_ADAPTER(solve_c_unoptimized, solve_unoptimized)
+
+// v3 guarda o tabuleiro também transposto (v3_sse recebe o mesmo)
+#define CACHE_ADAPTER(name, solver)                                   \
+    static int name(const uint8_t* puzzle, uint8_t* solution) {       \
+        struct Board_CacheOptimized in, out;                          \
+        board_to_cache_optimized(puzzle, &in);                        \
+        int found = solver(&in, &out);                                \
+        if (found)                                                    \
+            memcpy(solution, out.cells_row_major, 81);                \
+        return found;                                                 \
+    }
+
+CACHE_ADAPTER(solve_c_v3, solve_optimized_v3)
+CACHE_ADAPTER(solve_c_v3_sse, solve_optimized_v3_sse)
+
+// Pela ordem dos índices de main.c
+const struct sudoku_c_engine sudoku_c_engines[] = {
+    {"c_v0", solve_c_v0},
+    {"c_v1", solve_c_v1},
+    {"c_v2", solve_c_v2},
+    {"c_v3", solve_c_v3},
+    {"c_v4", solve_c_v4},
+    {"c_v5", solve_c_v5},
+    {"c_unoptimized", solve_c_unoptimized},
+    {"c_v6", solve_c_v6},
+    {"c_v3_sse", solve_c_v3_sse},
+};
+
+const int sudoku_c_engine_count = (int)(sizeof(sudoku_c_engines) / sizeof(sudoku_c_engines[0]));
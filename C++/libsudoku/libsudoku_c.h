@@ -0,0 +1,31 @@
+#ifndef LIBSUDOKU_C_H
+#define LIBSUDOKU_C_H
+
+#include <stdint.h>
+
+/*
+ * Solvers do diretório C vistos pela libsudoku (libsudoku_c.c).
+ * Ficam numa unidade C à parte porque o "struct Board" do C e o Board do
+ * C++ não podem estar no mesmo ficheiro.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 81 células de entrada e de saída; 1 se encontrou solução
+typedef int (*sudoku_cells_fn)(const uint8_t* puzzle, uint8_t* solution);
+
+struct sudoku_c_engine {
+    const char* name;
+    sudoku_cells_fn solve;
+};
+
+extern const struct sudoku_c_engine sudoku_c_engines[];
+extern const int sudoku_c_engine_count;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBSUDOKU_C_H
@@ -1,24 +1,103 @@
 #include "unoptimized/sudoku_unoptimize.hpp"
+#include "common/board_parse.hpp"
+#include "common/board_stream.hpp"
+#include "common/board_writer.hpp"
+#include "common/cpu_dispatch.hpp"
 
 #include <chrono>
+#include <cstring>
 #include <iostream>
 
+#include <unistd.h>
+
 long get_micros(const std::chrono::steady_clock::time_point& start,
                 const std::chrono::steady_clock::time_point& end) {
     return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
         .count();
 }
 
+// --------------------------------------------------
+// --stream: lê tabuleiros do stdin (linhas de 81 caracteres ou blocos de
+// 9 linhas) até ao EOF e escreve uma solução por linha no stdout.
+// Sem solução, o tabuleiro é escrito tal como veio.
+//
+// --flush auto  : flush antes de bloquear à espera de mais entrada (default)
+// --flush board : flush depois de cada tabuleiro
+// --flush end   : só quando o buffer enche e no fim
+
+enum class FlushMode { AUTO, BOARD, END };
+
+static int run_stream(FlushMode mode) {
+    BoardStreamReader reader(STDIN_FILENO);
+    BoardWriter writer(STDOUT_FILENO);
+
+    Board board;
+    Board solution;
+    long boards = 0;
+    long solved = 0;
+    int status;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while ((status = reader.next(board)) == 1) {
+        if (solve(board, solution) == 1) {
+            writer.write_board(solution);
+            solved++;
+        } else {
+            writer.write_board(board);
+        }
+        boards++;
+
+        if (mode == FlushMode::BOARD ||
+            (mode == FlushMode::AUTO && reader.would_block())) {
+            if (writer.flush() != 0)
+                return 1;
+        }
+    }
+
+    int write_err = writer.flush();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cerr << "Boards: " << boards << ", solved: " << solved
+              << ". Took " << get_micros(start, end) << "us\n";
+
+    if (status < 0) {
+        std::cerr << "Invalid board in input (after " << boards << " boards)\n";
+        return 1;
+    }
+    return write_err;
+}
+
 int main(int argc, char* argv[]) {
+    cpu_dispatch_log();
+
+    if (argc >= 2 && std::strcmp(argv[1], "--stream") == 0) {
+        FlushMode mode = FlushMode::AUTO;
+
+        if (argc >= 4 && std::strcmp(argv[2], "--flush") == 0) {
+            if (std::strcmp(argv[3], "board") == 0)
+                mode = FlushMode::BOARD;
+            else if (std::strcmp(argv[3], "end") == 0)
+                mode = FlushMode::END;
+            else if (std::strcmp(argv[3], "auto") != 0) {
+                std::cerr << "Unknown flush mode: " << argv[3] << "\n";
+                return 1;
+            }
+        }
+
+        return run_stream(mode);
+    }
+
     if (argc < 2) {
         std::cerr << "No sudoku file specified\n";
         return 1;
     }
 
-    std::string file_path = argv[1];
+    const char* file_path = argv[1];
     Board board;
 
-    if (read_file(board, file_path) != 0) {
+    // Um só read() para um buffer na stack (um processo por tabuleiro)
+    if (read_file_raw(board, file_path) != 0) {
         std::cerr << "Error reading file: " << file_path << "\n";
         return 1;
     }
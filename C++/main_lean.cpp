@@ -0,0 +1,111 @@
+#include "unoptimized/sudoku_unoptimize.hpp"
+#include "common/board_parse.hpp"
+#include "common/cpu_dispatch.hpp"
+
+#include <cstring>
+#include <ctime>
+
+#include <unistd.h>
+
+// --------------------------------------------------
+// CLI de um só tabuleiro para invocações a frio (lean_*.exe).
+//
+// Mesma saída que main.cpp sem --stream, mas sem <iostream> nem stdio: os
+// solvers são compilados com -DSUDOKU_LEAN (sem read_file/print_board) e o
+// executável é estático, por isso o arranque não tem linker dinâmico,
+// relocações da libstdc++ nem a inicialização dos streams.
+// Um read() para ler o tabuleiro (read_file_raw) e um write() para a saída.
+//
+// Uso: ./lean_dlx.exe <ficheiro>
+
+static long get_micros(const timespec& start, const timespec& end) {
+    return (end.tv_sec - start.tv_sec) * 1000000L + (end.tv_nsec - start.tv_nsec) / 1000;
+}
+
+// Acrescenta "s" em "p"; retorna o fim
+static char* put_str(char* p, const char* s) {
+    std::size_t n = std::strlen(s);
+    std::memcpy(p, s, n);
+    return p + n;
+}
+
+static char* put_long(char* p, long v) {
+    char tmp[24];
+    int n = 0;
+    if (v < 0) {
+        *p++ = '-';
+        v = -v;
+    }
+    do {
+        tmp[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (n)
+        *p++ = tmp[--n];
+    return p;
+}
+
+static int write_all(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n <= 0)
+            return 1;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return 0;
+}
+
+static int fail(const char* msg, const char* arg) {
+    char buf[512];
+    char* p = put_str(buf, msg);
+    if (arg) {
+        std::size_t n = std::strlen(arg);
+        if (n > 256)
+            n = 256;
+        std::memcpy(p, arg, n);
+        p += n;
+    }
+    *p++ = '\n';
+    write_all(STDERR_FILENO, buf, static_cast<std::size_t>(p - buf));
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    cpu_dispatch_log();
+
+    if (argc < 2)
+        return fail("No sudoku file specified", nullptr);
+
+    Board board;
+    if (read_file_raw(board, argv[1]) != 0)
+        return fail("Error reading file: ", argv[1]);
+
+    Board solution;
+
+    timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int found_solution = solve(board, solution);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long micros = get_micros(start, end);
+
+    // "Solution:\n" + 9 x 10 + "\nTook " + número + "us\n"
+    char out[160];
+    char* p = out;
+    if (found_solution) {
+        p = put_str(p, "Solution:\n");
+        for (int r = 0; r < 9; r++) {
+            for (int c = 0; c < 9; c++)
+                *p++ = static_cast<char>('0' + solution.cells[r * 9 + c]);
+            *p++ = '\n';
+        }
+        p = put_str(p, "\nTook ");
+    } else {
+        p = put_str(p, "No solution found. Took ");
+    }
+    p = put_long(p, micros);
+    p = put_str(p, "us\n");
+
+    return write_all(STDOUT_FILENO, out, static_cast<std::size_t>(p - out)) == 0 ? 0 : 1;
+}
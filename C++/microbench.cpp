@@ -0,0 +1,382 @@
+#include "bitmaskingrmvfc/sudoku_bitmasking_rmv_fc_internal.hpp"
+#include "common/bench.hpp"
+#include "common/board_packed.hpp"
+#include "common/cpu_dispatch.hpp"
+#include "dlx/sudoku_dlx_internal.hpp"
+#include "hybrid/sudoku_hybrid_internal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// --------------------------------------------------
+// Microbenchmarks das primitivas de cada solver, isoladas da procura:
+//   FC:     find_best_cell, propagate (+ undo), undo
+//   DLX:    cover + uncover da coluna escolhida
+//   hybrid: apply_logic
+//
+// Os estados são tabuleiros parciais apanhados em solves reais: a procura do
+// FC (as mesmas primitivas, pela ordem de solve_recursive) corre sobre os
+// tabuleiros de entrada e guarda um nó em cada "stride". Com --record os
+// estados ficam num ficheiro (uma linha de 81 caracteres por estado) e com
+// --states são lidos de lá, para comparar alterações a uma primitiva sempre
+// com os mesmos estados.
+//
+// Cada repetição passa por todos os estados: prepara o estado (fora do
+// tempo) e mede --inner chamadas seguidas (1 para apply_logic, que altera o
+// tabuleiro). O resultado é ns por chamada (mínimo, mediana, p90 das
+// repetições); "clock" é o custo de ler o relógio, incluído em cada estado.
+//
+// Uso: ./microbench.exe [--states FICHEIRO | --record FICHEIRO] [--max-states N]
+//                       [--reps R] [--inner K] [--csv FICHEIRO|-] [ficheiro_de_tabuleiros]
+// Sem ficheiro de tabuleiros: corpus/hard.txt
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    const char* boards = "corpus/hard.txt";
+    const char* states = nullptr;
+    const char* record = nullptr;
+    const char* csv_path = nullptr;
+    std::size_t max_states = 2000;
+    int reps = 15;
+    int inner = 16;
+};
+
+// --------------------------------------------------
+// Captura dos estados
+
+struct Capture {
+    std::vector<Board>* states = nullptr; // nullptr: só conta os nós
+    std::size_t stride = 1;
+    std::size_t nodes = 0;
+};
+
+// Igual a solve_recursive do FC, mas guarda o tabuleiro dos nós escolhidos
+static bool capture_search(Board& board, Capture& cap) {
+    int idx;
+    if (!fc_internal::find_best_cell(idx))
+        return true;
+
+    if (cap.states && cap.nodes % cap.stride == 0)
+        cap.states->push_back(board);
+    cap.nodes++;
+
+    uint16_t* domain = fc_internal::domains();
+    uint16_t avail = domain[idx];
+
+    while (avail) {
+        uint16_t bit = avail & -avail;
+        avail -= bit;
+
+        board.cells[idx] = static_cast<uint8_t>(__builtin_ctz(bit) + 1);
+
+        std::vector<FcChange> changes;
+        uint16_t old_domain = domain[idx];
+        domain[idx] = 0;
+
+        if (fc_internal::propagate(idx, bit, changes) && capture_search(board, cap))
+            return true;
+
+        board.cells[idx] = 0;
+        domain[idx] = old_domain;
+        fc_internal::undo(changes);
+    }
+    return false;
+}
+
+// Até max_states estados, repartidos pelos tabuleiros
+static void capture_states(const std::vector<Board>& boards, std::size_t max_states,
+                           std::vector<Board>& states) {
+    std::size_t per_board = std::max<std::size_t>(1, max_states / boards.size());
+
+    for (const Board& b : boards) {
+        // 1.ª passagem conta os nós, a 2.ª guarda ~per_board deles
+        Capture count;
+        Board work = b;
+        fc_internal::load(work);
+        capture_search(work, count);
+
+        Capture cap;
+        cap.states = &states;
+        cap.stride = std::max<std::size_t>(1, count.nodes / per_board);
+        work = b;
+        fc_internal::load(work);
+        capture_search(work, cap);
+
+        if (states.size() >= max_states)
+            break;
+    }
+    if (states.size() > max_states)
+        states.resize(max_states);
+}
+
+static int save_states(const char* path, const std::vector<Board>& states) {
+    FILE* f = std::fopen(path, "w");
+    if (!f)
+        return 1;
+    for (const Board& b : states) {
+        char line[82];
+        for (int i = 0; i < 81; i++)
+            line[i] = static_cast<char>('0' + b.cells[i]);
+        line[81] = '\n';
+        std::fwrite(line, 1, sizeof(line), f);
+    }
+    return std::fclose(f) == 0 ? 0 : 1;
+}
+
+// --------------------------------------------------
+// Primitivas
+
+/*
+ * setup prepara o estado i (fora do tempo) e diz se a primitiva se aplica;
+ * run é o que se mede, "inner" vezes seguidas.
+ */
+struct Kernel {
+    const char* engine;
+    const char* name;
+    int inner; // 0: usa --inner
+    std::function<bool(const Board&)> setup;
+    std::function<void()> run;
+    std::function<void()> teardown;
+};
+
+struct KernelResult {
+    const Kernel* kernel = nullptr;
+    std::size_t states = 0;
+    std::uint64_t calls = 0;
+    SampleStats stats; // ns por chamada, uma amostra por repetição
+};
+
+static KernelResult measure(const Kernel& k, const std::vector<Board>& states, int reps,
+                            int inner) {
+    KernelResult res;
+    res.kernel = &k;
+    std::vector<double> samples;
+
+    for (int rep = 0; rep < reps; rep++) {
+        std::uint64_t ns = 0;
+        std::uint64_t calls = 0;
+        std::size_t used = 0;
+
+        for (const Board& s : states) {
+            if (!k.setup(s))
+                continue;
+
+            auto t0 = Clock::now();
+            for (int i = 0; i < inner; i++)
+                k.run();
+            auto t1 = Clock::now();
+
+            if (k.teardown)
+                k.teardown();
+            ns += static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            calls += static_cast<std::uint64_t>(inner);
+            used++;
+        }
+
+        if (calls)
+            samples.push_back(double(ns) / double(calls));
+        res.states = used;
+        res.calls += calls;
+    }
+
+    res.stats = compute_stats(samples);
+    return res;
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+
+        if (std::strncmp(arg, "--", 2) != 0) {
+            opt.boards = arg;
+        } else if (i + 1 >= argc) {
+            return false;
+        } else if (std::strcmp(arg, "--states") == 0) {
+            opt.states = argv[++i];
+        } else if (std::strcmp(arg, "--record") == 0) {
+            opt.record = argv[++i];
+        } else if (std::strcmp(arg, "--max-states") == 0) {
+            opt.max_states = static_cast<std::size_t>(std::atol(argv[++i]));
+        } else if (std::strcmp(arg, "--reps") == 0) {
+            opt.reps = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--inner") == 0) {
+            opt.inner = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            opt.csv_path = argv[++i];
+        } else {
+            return false;
+        }
+    }
+
+    if (opt.reps < 1)
+        opt.reps = 1;
+    if (opt.inner < 1)
+        opt.inner = 1;
+    if (opt.max_states == 0)
+        opt.max_states = 1;
+    return !(opt.states && opt.record);
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--states FILE | --record FILE] [--max-states N] [--reps R]\n"
+                     "          [--inner K] [--csv FILE|-] [boards_file]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Board> states;
+    if (opt.states) {
+        if (load_boards(opt.states, states) != 0 || states.empty()) {
+            std::fprintf(stderr, "Error reading states: %s\n", opt.states);
+            return 1;
+        }
+    } else {
+        std::vector<Board> boards;
+        if (load_boards(opt.boards, boards) != 0 || boards.empty()) {
+            std::fprintf(stderr, "Error reading file: %s (see build_corpus.sh)\n", opt.boards);
+            return 1;
+        }
+        capture_states(boards, opt.max_states, states);
+
+        if (opt.record && save_states(opt.record, states) != 0) {
+            std::fprintf(stderr, "Cannot write %s\n", opt.record);
+            return 1;
+        }
+    }
+
+    // Estado partilhado pelas primitivas (o dos solvers é thread_local)
+    Board work;
+    int idx = 0;
+    int column = -1;
+    uint16_t bit = 0;
+    uint16_t old_domain = 0;
+    bool ok = false;
+    std::vector<FcChange> changes;
+    changes.reserve(81);
+
+    // Célula escolhida pelo MRV e o primeiro valor, como na procura
+    auto fc_choose = [&](const Board& s) {
+        fc_internal::load(s);
+        if (!fc_internal::find_best_cell(idx))
+            return false;
+        uint16_t* domain = fc_internal::domains();
+        bit = static_cast<uint16_t>(domain[idx] & -domain[idx]);
+        old_domain = domain[idx];
+        domain[idx] = 0;
+        return true;
+    };
+
+    const std::vector<Kernel> kernels = {
+        {"-", "clock", 1, [](const Board&) { return true; }, [] {}, nullptr},
+
+        {"bitmasking_fc", "find_best_cell", 0,
+         [&](const Board& s) {
+             fc_internal::load(s);
+             return true;
+         },
+         [&] {
+             ok = fc_internal::find_best_cell(idx);
+             do_not_optimize(ok);
+             do_not_optimize(idx);
+         },
+         nullptr},
+
+        // Par propagate + undo: é o que a procura faz em cada valor
+        {"bitmasking_fc", "propagate+undo", 0, fc_choose,
+         [&] {
+             changes.clear();
+             ok = fc_internal::propagate(idx, bit, changes);
+             do_not_optimize(ok);
+             fc_internal::undo(changes);
+         },
+         [&] { fc_internal::domains()[idx] = old_domain; }},
+
+        // undo repõe sempre os mesmos valores, pode repetir-se
+        {"bitmasking_fc", "undo", 0,
+         [&](const Board& s) {
+             if (!fc_choose(s))
+                 return false;
+             changes.clear();
+             fc_internal::propagate(idx, bit, changes);
+             return true;
+         },
+         [&] {
+             fc_internal::undo(changes);
+             clobber_memory();
+         },
+         [&] { fc_internal::domains()[idx] = old_domain; }},
+
+        {"dlx", "cover+uncover", 0,
+         [&](const Board& s) {
+             dlx_internal::load(s);
+             column = dlx_internal::choose_column();
+             return column >= 0 && dlx_internal::column_size(column) > 0;
+         },
+         [&] {
+             dlx_internal::cover(column);
+             dlx_internal::uncover(column);
+             clobber_memory();
+         },
+         nullptr},
+
+        // Altera o tabuleiro: uma chamada por estado
+        {"hybrid", "apply_logic", 1,
+         [&](const Board& s) {
+             work = s;
+             hybrid_internal::load(work);
+             return true;
+         },
+         [&] {
+             ok = hybrid_internal::apply_logic(work);
+             do_not_optimize(ok);
+         },
+         nullptr},
+    };
+
+    FILE* table = opt.csv_path && std::strcmp(opt.csv_path, "-") == 0 ? stderr : stdout;
+    std::fprintf(table, "States     : %zu (%s)\n", states.size(),
+                 opt.states ? opt.states : opt.boards);
+    std::fprintf(table, "Runs       : %d repetitions, %d calls per state\n", opt.reps,
+                 opt.inner);
+    std::fprintf(table, "Dispatch   : %s\n\n", cpu_dispatch_level());
+    std::fprintf(table, "%-14s %-16s %7s %10s %10s %10s %10s\n", "engine", "kernel", "states",
+                 "calls", "min_ns", "median_ns", "p90_ns");
+
+    std::vector<KernelResult> results;
+    for (const Kernel& k : kernels) {
+        KernelResult r = measure(k, states, opt.reps, k.inner ? k.inner : opt.inner);
+        std::fprintf(table, "%-14s %-16s %7zu %10llu %10.1f %10.1f %10.1f\n", k.engine, k.name,
+                     r.states, static_cast<unsigned long long>(r.calls), r.stats.min,
+                     r.stats.median, r.stats.p90);
+        std::fflush(table);
+        results.push_back(r);
+    }
+
+    if (opt.csv_path) {
+        FILE* csv = std::strcmp(opt.csv_path, "-") == 0 ? stdout : std::fopen(opt.csv_path, "w");
+        if (!csv) {
+            std::fprintf(stderr, "Cannot write %s\n", opt.csv_path);
+            return 1;
+        }
+        std::fprintf(csv, "engine,kernel,states,calls,min_ns,median_ns,mean_ns,p90_ns,stddev_ns\n");
+        for (const KernelResult& r : results) {
+            std::fprintf(csv, "%s,%s,%zu,%llu,%.2f,%.2f,%.2f,%.2f,%.2f\n", r.kernel->engine,
+                         r.kernel->name, r.states, static_cast<unsigned long long>(r.calls),
+                         r.stats.min, r.stats.median, r.stats.mean, r.stats.p90, r.stats.stddev);
+        }
+        if (csv != stdout)
+            std::fclose(csv);
+    }
+    return 0;
+}
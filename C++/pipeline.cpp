@@ -0,0 +1,361 @@
+#include "unoptimized/sudoku_unoptimize.hpp"
+#include "common/board_stream.hpp"
+#include "common/board_writer.hpp"
+#include "common/cpu_dispatch.hpp"
+#include "common/mpmc_ring.hpp"
+#include "common/latency_histogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Pipeline: leitor -> N solvers -> writer ordenado.
+//
+// Os lotes (Batch) vêm de um pool fixo: o leitor só avança quando o writer
+// devolve um lote ao pool, por isso a memória não depende do tamanho da
+// entrada (backpressure). O writer escreve os lotes pela ordem de leitura.
+// Cada solver regista o tempo de cada tabuleiro no seu próprio histograma;
+// só se juntam no fim, depois do join (sem locks nem atomics por solve).
+//
+// Uso: ./pipeline_<solver>.exe [--threads N] [--batch B] [--inflight P]
+//                              [--packed] [--hist F] [--hist-csv F]
+//                              <ficheiro|-> [ficheiro_de_saída]
+
+using Clock = std::chrono::steady_clock;
+
+struct Batch {
+    std::uint64_t seq = 0;
+    std::size_t count = 0;
+    std::vector<Board> boards;
+};
+
+// Contadores por stage, cada um na sua linha de cache
+struct alignas(64) StageStats {
+    std::uint64_t busy_ns = 0;
+    std::uint64_t wait_ns = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t boards = 0;
+    std::uint64_t solved = 0;
+};
+
+struct Options {
+    unsigned threads = 0;
+    std::size_t batch = 256;
+    std::size_t inflight = 0;
+    BoardFormat format = BoardFormat::LINES;
+    const char* in_path = nullptr;
+    const char* out_path = nullptr;
+    const char* hist_path = nullptr;
+    const char* hist_csv_path = nullptr;
+};
+
+static std::uint64_t elapsed_ns(Clock::time_point start, Clock::time_point end) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-' && argv[i][1] == '-'; i++) {
+        if (std::strcmp(argv[i], "--packed") == 0)
+            opt.format = BoardFormat::PACKED;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            opt.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+            opt.batch = static_cast<std::size_t>(std::atol(argv[++i]));
+        else if (std::strcmp(argv[i], "--inflight") == 0 && i + 1 < argc)
+            opt.inflight = static_cast<std::size_t>(std::atol(argv[++i]));
+        else if (std::strcmp(argv[i], "--hist") == 0 && i + 1 < argc)
+            opt.hist_path = argv[++i];
+        else if (std::strcmp(argv[i], "--hist-csv") == 0 && i + 1 < argc)
+            opt.hist_csv_path = argv[++i];
+        else
+            return false;
+    }
+
+    if (i >= argc)
+        return false;
+
+    opt.in_path = argv[i];
+    opt.out_path = i + 1 < argc ? argv[i + 1] : nullptr;
+
+    if (opt.threads == 0)
+        opt.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    if (opt.batch == 0)
+        opt.batch = 1;
+    if (opt.inflight == 0)
+        opt.inflight = 4 * opt.threads;
+
+    return true;
+}
+
+static void print_stage(const char* name, const StageStats& s, std::uint64_t wall_ns) {
+    std::fprintf(stderr, "%-10s %7.1f%% %7.1f%% %10llu %12llu\n",
+                 name,
+                 100.0 * double(s.busy_ns) / double(wall_ns),
+                 100.0 * double(s.wait_ns) / double(wall_ns),
+                 static_cast<unsigned long long>(s.batches),
+                 static_cast<unsigned long long>(s.boards));
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--threads N] [--batch B] [--inflight P] [--packed]\n"
+                     "          [--hist file] [--hist-csv file] <boards_file|-> [output_file]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    int in_fd = STDIN_FILENO;
+    if (std::strcmp(opt.in_path, "-") != 0) {
+        in_fd = open(opt.in_path, O_RDONLY);
+        if (in_fd < 0) {
+            std::fprintf(stderr, "Error reading file: %s\n", opt.in_path);
+            return 1;
+        }
+    }
+
+    int out_fd = STDOUT_FILENO;
+    if (opt.out_path) {
+        out_fd = open(opt.out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out_fd < 0) {
+            std::fprintf(stderr, "Error opening output: %s\n", opt.out_path);
+            return 1;
+        }
+    }
+
+    // --------------------------------------------------
+    // Pool fixo de lotes e as três filas
+
+    std::vector<Batch> pool(opt.inflight);
+    MpmcRing<Batch*> free_ring(opt.inflight);
+    MpmcRing<Batch*> work_ring(opt.inflight);
+    MpmcRing<Batch*> done_ring(opt.inflight);
+
+    for (Batch& b : pool) {
+        b.boards.resize(opt.batch);
+        free_ring.push(&b);
+    }
+
+    StageStats reader_stats;
+    StageStats writer_stats;
+    std::vector<StageStats> worker_stats(opt.threads);
+    std::vector<LatencyReport> worker_latency(opt.threads);
+    const std::string engine_name = engine_name_from_program(argv[0]);
+    std::atomic<bool> read_error{false};
+    std::atomic<unsigned> active_workers{opt.threads};
+
+    auto start = Clock::now();
+
+    // --------------------------------------------------
+    // Leitor
+
+    std::thread reader([&] {
+        BoardStreamReader stream(in_fd);
+        std::uint64_t seq = 0;
+        int status = 1;
+
+        while (status == 1) {
+            auto t0 = Clock::now();
+            Batch* b;
+            free_ring.pop(b);
+            auto t1 = Clock::now();
+
+            b->count = stream.next_batch(b->boards.data(), opt.batch, status);
+            b->seq = seq;
+            auto t2 = Clock::now();
+
+            reader_stats.wait_ns += elapsed_ns(t0, t1);
+            reader_stats.busy_ns += elapsed_ns(t1, t2);
+
+            if (b->count == 0) {
+                free_ring.push(b);
+                break;
+            }
+
+            seq++;
+            reader_stats.batches++;
+            reader_stats.boards += b->count;
+            work_ring.push(b);
+        }
+
+        if (status < 0)
+            read_error.store(true);
+        work_ring.close();
+    });
+
+    // --------------------------------------------------
+    // Solvers
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < opt.threads; w++) {
+        workers.emplace_back([&, w] {
+            StageStats& st = worker_stats[w];
+            LatencyReport& latency = worker_latency[w];
+            LatencyReport::Entry& hist = latency.engine(engine_name);
+            Batch* b;
+
+            for (;;) {
+                auto t0 = Clock::now();
+                bool got = work_ring.pop(b);
+                auto t1 = Clock::now();
+                st.wait_ns += elapsed_ns(t0, t1);
+                if (!got)
+                    break;
+
+                for (std::size_t i = 0; i < b->count; i++) {
+                    Board solution;
+                    auto s0 = Clock::now();
+                    int found = solve(b->boards[i], solution);
+                    latency.record(hist, b->boards[i], elapsed_ns(s0, Clock::now()));
+
+                    if (found == 1) {
+                        b->boards[i] = solution;
+                        st.solved++;
+                    }
+                }
+
+                auto t2 = Clock::now();
+                st.busy_ns += elapsed_ns(t1, t2);
+                st.batches++;
+                st.boards += b->count;
+
+                done_ring.push(b);
+            }
+
+            if (active_workers.fetch_sub(1) == 1)
+                done_ring.close();
+        });
+    }
+
+    // --------------------------------------------------
+    // Writer (nesta thread): reordena por "seq"
+
+    int write_err;
+    {
+        BoardWriter writer(out_fd, opt.format);
+        std::vector<Batch*> pending(opt.inflight, nullptr);
+        std::uint64_t next_seq = 0;
+
+        for (;;) {
+            auto t0 = Clock::now();
+            Batch* b;
+            bool got = done_ring.pop(b);
+            auto t1 = Clock::now();
+            writer_stats.wait_ns += elapsed_ns(t0, t1);
+            if (!got)
+                break;
+
+            // No máximo "inflight" lotes em circulação: seq % inflight é único
+            pending[b->seq % opt.inflight] = b;
+
+            Batch* ready;
+            while ((ready = pending[next_seq % opt.inflight]) != nullptr &&
+                   ready->seq == next_seq) {
+                for (std::size_t i = 0; i < ready->count; i++)
+                    writer.write_board(ready->boards[i]);
+
+                writer_stats.batches++;
+                writer_stats.boards += ready->count;
+
+                pending[next_seq % opt.inflight] = nullptr;
+                next_seq++;
+                free_ring.push(ready);
+            }
+
+            writer_stats.busy_ns += elapsed_ns(t1, Clock::now());
+        }
+
+        auto t2 = Clock::now();
+        write_err = writer.flush();
+        writer_stats.busy_ns += elapsed_ns(t2, Clock::now());
+    }
+
+    reader.join();
+    for (std::thread& t : workers)
+        t.join();
+
+    auto end = Clock::now();
+    std::uint64_t wall_ns = elapsed_ns(start, end);
+
+    if (in_fd != STDIN_FILENO)
+        close(in_fd);
+    if (out_fd != STDOUT_FILENO)
+        close(out_fd);
+
+    // --------------------------------------------------
+    // Relatório (stderr)
+
+    StageStats all_workers;
+    for (const StageStats& s : worker_stats) {
+        all_workers.busy_ns += s.busy_ns;
+        all_workers.wait_ns += s.wait_ns;
+        all_workers.batches += s.batches;
+        all_workers.boards += s.boards;
+        all_workers.solved += s.solved;
+    }
+
+    std::fprintf(stderr, "Pipeline report\n");
+    std::fprintf(stderr, "-----------------------------\n");
+    std::fprintf(stderr, "Solver threads : %u\n", opt.threads);
+    std::fprintf(stderr, "Dispatch       : %s\n", cpu_dispatch_level());
+    std::fprintf(stderr, "Batch size     : %zu\n", opt.batch);
+    std::fprintf(stderr, "In flight      : %zu batches\n", opt.inflight);
+    std::fprintf(stderr, "Boards         : %llu (solved %llu)\n",
+                 static_cast<unsigned long long>(writer_stats.boards),
+                 static_cast<unsigned long long>(all_workers.solved));
+    std::fprintf(stderr, "Wall time      : %.3f ms\n", double(wall_ns) / 1e6);
+    std::fprintf(stderr, "Throughput     : %.0f boards/s\n\n",
+                 double(writer_stats.boards) / (double(wall_ns) / 1e9));
+
+    std::fprintf(stderr, "%-10s %8s %8s %10s %12s\n", "stage", "busy", "wait", "batches", "boards");
+    print_stage("reader", reader_stats, wall_ns);
+    for (unsigned w = 0; w < opt.threads; w++) {
+        char name[24];
+        std::snprintf(name, sizeof(name), "solver%u", w);
+        print_stage(name, worker_stats[w], wall_ns);
+    }
+    print_stage("writer", writer_stats, wall_ns);
+
+    LatencyReport latency;
+    for (const LatencyReport& r : worker_latency)
+        latency.merge(r);
+
+    std::fprintf(stderr, "\n");
+    latency.print(stderr);
+
+    std::fprintf(stderr, "\nQueue waits (full/empty): free %llu/%llu, work %llu/%llu, done %llu/%llu\n",
+                 static_cast<unsigned long long>(free_ring.full_waits()),
+                 static_cast<unsigned long long>(free_ring.empty_waits()),
+                 static_cast<unsigned long long>(work_ring.full_waits()),
+                 static_cast<unsigned long long>(work_ring.empty_waits()),
+                 static_cast<unsigned long long>(done_ring.full_waits()),
+                 static_cast<unsigned long long>(done_ring.empty_waits()));
+
+    if (read_error.load()) {
+        std::fprintf(stderr, "Error: invalid board in input\n");
+        return 1;
+    }
+    if (opt.hist_path && latency.save(opt.hist_path) != 0) {
+        std::fprintf(stderr, "Error writing histogram: %s\n", opt.hist_path);
+        return 1;
+    }
+    if (opt.hist_csv_path && latency.write_csv(opt.hist_csv_path) != 0) {
+        std::fprintf(stderr, "Error writing histogram: %s\n", opt.hist_csv_path);
+        return 1;
+    }
+
+    return write_err;
+}
@@ -0,0 +1,261 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../libsudoku/libsudoku.h"
+
+// --------------------------------------------------
+// Módulo Python "sudoku_native": os solvers da libsudoku para lotes de
+// tabuleiros, sem cópias e sem o GIL.
+//
+//   solutions, status = sudoku_native.solve_batch(puzzles, engine="dlx",
+//                                                 threads=0, out=None, status=None)
+//
+// "puzzles" é qualquer objeto com o buffer protocol, contíguo, de bytes
+// (uint8): um array NumPy (N, 81), bytes, bytearray, memoryview...
+// Os tabuleiros são lidos diretamente desse buffer e as soluções escritas
+// diretamente em "out" (N * 81 bytes); "status" recebe N valores int8
+// (SUDOKU_SOLVED = 1, SUDOKU_NO_SOLUTION = 0, SUDOKU_INVALID = -1).
+// Sem "out"/"status" são criados arrays NumPy (ou array.array sem NumPy);
+// out=puzzles resolve no próprio array.
+//
+// O lote é resolvido com o GIL libertado, em "threads" threads (0 = uma por
+// CPU), cada uma com o seu sudoku_solver, em blocos tirados de um contador
+// atómico (os tabuleiros difíceis não ficam todos na mesma thread).
+
+static constexpr std::size_t CHUNK = 64; // tabuleiros por bloco
+
+// Buffer de bytes contíguo; libertado no destrutor
+struct ByteView {
+    Py_buffer view{};
+    bool held = false;
+
+    ~ByteView() {
+        if (held)
+            PyBuffer_Release(&view);
+    }
+
+    bool get(PyObject* obj, bool writable, const char* what) {
+        int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+        if (PyObject_GetBuffer(obj, &view, flags) != 0)
+            return false;
+        held = true;
+
+        const char* f = view.format ? view.format : "B";
+        if (view.itemsize != 1 || (std::strcmp(f, "B") != 0 && std::strcmp(f, "b") != 0 &&
+                                   std::strcmp(f, "c") != 0)) {
+            PyErr_Format(PyExc_TypeError, "%s must be a buffer of uint8/int8", what);
+            return false;
+        }
+        return true;
+    }
+
+    std::uint8_t* data() const { return static_cast<std::uint8_t*>(view.buf); }
+};
+
+// numpy.empty(shape, dtype); sem NumPy, array.array(typecode, bytes(n))
+static PyObject* new_array(Py_ssize_t rows, Py_ssize_t cols, const char* dtype,
+                           const char* typecode) {
+    Py_ssize_t n = rows * cols;
+    PyObject* np = PyImport_ImportModule("numpy");
+    if (np) {
+        PyObject* shape = cols > 1 ? Py_BuildValue("(nn)", rows, cols) : Py_BuildValue("(n)", rows);
+        PyObject* arr = shape ? PyObject_CallMethod(np, "empty", "Os", shape, dtype) : nullptr;
+        Py_XDECREF(shape);
+        Py_DECREF(np);
+        return arr;
+    }
+    PyErr_Clear();
+
+    PyObject* mod = PyImport_ImportModule("array");
+    if (!mod)
+        return nullptr;
+    PyObject* zeros = PyBytes_FromStringAndSize(nullptr, n);
+    PyObject* arr = nullptr;
+    if (zeros) {
+        std::memset(PyBytes_AS_STRING(zeros), 0, static_cast<std::size_t>(n));
+        arr = PyObject_CallMethod(mod, "array", "sO", typecode, zeros);
+    }
+    Py_XDECREF(zeros);
+    Py_DECREF(mod);
+    return arr;
+}
+
+// --------------------------------------------------
+// Lote em paralelo (sem o GIL)
+
+struct Batch {
+    const char* engine;
+    const std::uint8_t* puzzles;
+    std::uint8_t* solutions;
+    std::int8_t* status;
+    std::size_t count;
+    std::atomic<std::size_t> next{0};
+};
+
+static void worker(Batch& b) {
+    sudoku_solver* solver = sudoku_solver_create(b.engine);
+    if (!solver)
+        return;
+
+    for (;;) {
+        std::size_t first = b.next.fetch_add(CHUNK);
+        if (first >= b.count)
+            break;
+        std::size_t n = std::min(CHUNK, b.count - first);
+        sudoku_solve_batch(solver, b.puzzles + first * 81, b.solutions + first * 81, n,
+                           b.status + first);
+    }
+
+    sudoku_solver_destroy(solver);
+}
+
+static void run_batch(Batch& b, unsigned threads) {
+    if (threads <= 1 || b.count <= CHUNK) {
+        worker(b);
+        return;
+    }
+
+    std::size_t chunks = (b.count + CHUNK - 1) / CHUNK;
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; t++)
+        pool.emplace_back(worker, std::ref(b));
+    worker(b);
+    for (std::thread& t : pool)
+        t.join();
+}
+
+// --------------------------------------------------
+// Funções do módulo
+
+static PyObject* py_solve_batch(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* kwlist[] = {"puzzles", "engine", "threads", "out", "status", nullptr};
+    PyObject* puzzles_obj;
+    const char* engine = "dlx";
+    int threads = 0;
+    PyObject* out_obj = Py_None;
+    PyObject* status_obj = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|siOO", const_cast<char**>(kwlist),
+                                     &puzzles_obj, &engine, &threads, &out_obj, &status_obj))
+        return nullptr;
+
+    if (sudoku_engine_find(engine) < 0)
+        return PyErr_Format(PyExc_ValueError, "unknown engine: %s", engine);
+
+    ByteView puzzles;
+    if (!puzzles.get(puzzles_obj, false, "puzzles"))
+        return nullptr;
+    if (puzzles.view.len % 81 != 0)
+        return PyErr_Format(PyExc_ValueError, "puzzles must hold N * 81 cells, got %zd",
+                            puzzles.view.len);
+    Py_ssize_t count = puzzles.view.len / 81;
+
+    // Saídas: as do chamador ou novas (a referência devolvida é nossa)
+    PyObject* out = out_obj;
+    PyObject* status = status_obj;
+    if (out == Py_None)
+        out = new_array(count, 81, "uint8", "B");
+    else
+        Py_INCREF(out);
+    if (!out)
+        return nullptr;
+    if (status == Py_None)
+        status = new_array(count, 1, "int8", "b");
+    else
+        Py_INCREF(status);
+    if (!status) {
+        Py_DECREF(out);
+        return nullptr;
+    }
+
+    {
+        ByteView sol, st;
+        bool ok = sol.get(out, true, "out") && st.get(status, true, "status");
+        if (ok && sol.view.len != puzzles.view.len) {
+            PyErr_SetString(PyExc_ValueError, "out must have the same size as puzzles");
+            ok = false;
+        }
+        if (ok && st.view.len != count) {
+            PyErr_SetString(PyExc_ValueError, "status must hold one int8 per puzzle");
+            ok = false;
+        }
+        if (!ok) {
+            Py_DECREF(out);
+            Py_DECREF(status);
+            return nullptr;
+        }
+
+        unsigned n_threads = threads > 0 ? static_cast<unsigned>(threads)
+                                         : std::max(1u, std::thread::hardware_concurrency());
+        Batch b;
+        b.engine = engine;
+        b.puzzles = puzzles.data();
+        b.solutions = sol.data();
+        b.status = reinterpret_cast<std::int8_t*>(st.data());
+        b.count = static_cast<std::size_t>(count);
+
+        Py_BEGIN_ALLOW_THREADS
+        run_batch(b, n_threads);
+        Py_END_ALLOW_THREADS
+    }
+
+    return Py_BuildValue("(NN)", out, status);
+}
+
+static PyObject* py_engines(PyObject*, PyObject*) {
+    int n = sudoku_engine_count();
+    PyObject* names = PyTuple_New(n);
+    if (!names)
+        return nullptr;
+    for (int i = 0; i < n; i++) {
+        PyObject* s = PyUnicode_FromString(sudoku_engine_name(i));
+        if (!s) {
+            Py_DECREF(names);
+            return nullptr;
+        }
+        PyTuple_SET_ITEM(names, i, s);
+    }
+    return names;
+}
+
+static PyMethodDef METHODS[] = {
+    {"solve_batch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(py_solve_batch)),
+     METH_VARARGS | METH_KEYWORDS,
+     "solve_batch(puzzles, engine='dlx', threads=0, out=None, status=None)\n"
+     "-> (solutions, status)\n\n"
+     "Solves N boards (N * 81 uint8 cells, 0 = empty) in parallel without the GIL."},
+    {"engines", py_engines, METH_NOARGS, "engines() -> tuple of engine names"},
+    {nullptr, nullptr, 0, nullptr}};
+
+static PyModuleDef MODULE = {PyModuleDef_HEAD_INIT,
+                             "sudoku_native",
+                             "Native sudoku engines (libsudoku) for batches of boards.",
+                             -1,
+                             METHODS,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             nullptr};
+
+PyMODINIT_FUNC PyInit_sudoku_native(void) {
+    PyObject* m = PyModule_Create(&MODULE);
+    if (!m)
+        return nullptr;
+    if (PyModule_AddIntConstant(m, "SOLVED", SUDOKU_SOLVED) != 0 ||
+        PyModule_AddIntConstant(m, "NO_SOLUTION", SUDOKU_NO_SOLUTION) != 0 ||
+        PyModule_AddIntConstant(m, "INVALID", SUDOKU_INVALID) != 0) {
+        Py_DECREF(m);
+        return nullptr;
+    }
+    return m;
+}
@@ -0,0 +1,137 @@
+#include "../common/board_packed.hpp"
+#include "../common/board_parse.hpp"
+#include "../common/board_writer.hpp"
+#include "protocol.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+
+// --------------------------------------------------
+// Cliente de teste do serviço: envia os tabuleiros de um ficheiro
+// (linhas, formato compacto ou um tabuleiro de 9 linhas como os de
+// ../boards; "-" para stdin), com até W pedidos em
+// curso, escreve as respostas no stdout (uma por linha) e confirma que
+// cada solução é válida e respeita as pistas do pedido.
+//
+// Uso: ./service_client.exe [--socket PATH] [--window W] <ficheiro|->
+// Retorna 0 se todas as respostas estiverem corretas.
+
+// Cada linha, coluna e caixa tem 1-9 uma vez, e as pistas foram mantidas
+static bool is_valid_solution(const Board& puzzle, const Board& solution) {
+    for (int i = 0; i < 81; i++) {
+        if (solution.cells[i] < 1 || solution.cells[i] > 9)
+            return false;
+        if (puzzle.cells[i] != 0 && puzzle.cells[i] != solution.cells[i])
+            return false;
+    }
+
+    for (int unit = 0; unit < 9; unit++) {
+        unsigned row = 0, col = 0, box = 0;
+        for (int k = 0; k < 9; k++) {
+            int br = (unit / 3) * 3 + k / 3;
+            int bc = (unit % 3) * 3 + k % 3;
+            row |= 1u << solution.cells[unit * 9 + k];
+            col |= 1u << solution.cells[k * 9 + unit];
+            box |= 1u << solution.cells[br * 9 + bc];
+        }
+        if (row != 0x3FE || col != 0x3FE || box != 0x3FE)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const char* socket_path = SERVICE_DEFAULT_SOCKET;
+    std::size_t window = 64;
+    int i = 1;
+
+    for (; i < argc && argv[i][0] == '-' && argv[i][1] == '-'; i++) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+            socket_path = argv[++i];
+        else if (std::strcmp(argv[i], "--window") == 0 && i + 1 < argc)
+            window = static_cast<std::size_t>(std::atol(argv[++i]));
+        else
+            break;
+    }
+
+    const char* in_path = i + 1 == argc ? argv[i] : nullptr;
+    if (!in_path || window == 0) {
+        std::fprintf(stderr, "Usage: %s [--socket PATH] [--window W] <boards_file|->\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Board> boards;
+    const char* load_path = std::strcmp(in_path, "-") == 0 ? "/dev/stdin" : in_path;
+    if (load_boards(load_path, boards) != 0) {
+        Board single;
+        if (read_file_raw(single, load_path) == 0) {
+            boards.assign(1, single);
+        } else {
+            std::fprintf(stderr, "Error reading file: %s\n", in_path);
+            return 1;
+        }
+    }
+
+    int fd = connect_unix(socket_path);
+    if (fd < 0) {
+        std::fprintf(stderr, "Cannot connect to %s\n", socket_path);
+        return 1;
+    }
+
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    std::size_t solved = 0;
+    std::size_t no_solution = 0;
+    std::size_t wrong = 0;
+    int err = 0;
+
+    {
+        BoardWriter writer(STDOUT_FILENO);
+        char frame[RESPONSE_FRAME_SIZE];
+
+        while (received < boards.size()) {
+            // Enche a janela; as respostas chegam pela mesma ordem
+            while (sent < boards.size() && sent - received < window) {
+                encode_request(boards[sent], frame);
+                if (send_all(fd, frame, REQUEST_FRAME_SIZE) != 0) {
+                    err = 1;
+                    break;
+                }
+                sent++;
+            }
+
+            if (err || recv_all(fd, frame, RESPONSE_FRAME_SIZE) != 0) {
+                err = 1;
+                break;
+            }
+
+            Board answer;
+            const Board& puzzle = boards[received++];
+            int status = decode_response(frame, answer);
+
+            if (status == STATUS_SOLVED && is_valid_solution(puzzle, answer)) {
+                solved++;
+            } else if (status == STATUS_NO_SOLUTION && answer.cells == puzzle.cells) {
+                no_solution++;
+            } else {
+                wrong++;
+                std::fprintf(stderr, "Bad response for board %zu (status %d)\n", received, status);
+            }
+            writer.write_board(answer);
+        }
+        err |= writer.flush();
+    }
+
+    close(fd);
+
+    std::fprintf(stderr, "Boards: %zu, solved: %zu, no solution: %zu, bad responses: %zu\n",
+                 boards.size(), solved, no_solution, wrong);
+    if (err)
+        std::fprintf(stderr, "Connection error after %zu responses\n", received);
+
+    return (err || wrong) ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+#include "../common/board_packed.hpp"
+#include "protocol.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+// --------------------------------------------------
+// Gerador de carga para o serviço: C ligações (uma thread cada), cada uma
+// com D pedidos em curso (closed loop). Os tabuleiros do ficheiro são
+// enviados em ciclo. Mede a latência de cada pedido (do envio à resposta)
+// e o throughput total.
+//
+// Uso: ./service_loadgen.exe [--socket PATH] [--connections C] [--depth D]
+//                            [--requests N | --seconds S] <ficheiro>
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    const char* socket_path = SERVICE_DEFAULT_SOCKET;
+    unsigned connections = 4;
+    std::size_t depth = 8;
+    std::uint64_t requests = 100000; // total, dividido pelas ligações
+    double seconds = 0;              // > 0: corre por tempo em vez de por número
+    const char* in_path = nullptr;
+};
+
+struct ConnResult {
+    std::vector<std::uint64_t> latencies_ns;
+    bool error = false;
+};
+
+static std::uint64_t elapsed_ns(Clock::time_point start, Clock::time_point end) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-' && argv[i][1] == '-'; i++) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+            opt.socket_path = argv[++i];
+        else if (std::strcmp(argv[i], "--connections") == 0 && i + 1 < argc)
+            opt.connections = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc)
+            opt.depth = static_cast<std::size_t>(std::atol(argv[++i]));
+        else if (std::strcmp(argv[i], "--requests") == 0 && i + 1 < argc)
+            opt.requests = static_cast<std::uint64_t>(std::atoll(argv[++i]));
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            opt.seconds = std::atof(argv[++i]);
+        else
+            return false;
+    }
+
+    if (i + 1 != argc || opt.connections == 0 || opt.depth == 0)
+        return false;
+    opt.in_path = argv[i];
+    return true;
+}
+
+static void run_connection(const Options& opt, const std::vector<Board>& boards,
+                           std::uint64_t quota, unsigned offset,
+                           std::atomic<bool>& stop, ConnResult& result) {
+    int fd = connect_unix(opt.socket_path);
+    if (fd < 0) {
+        result.error = true;
+        return;
+    }
+
+    // Instantes de envio dos pedidos em curso (FIFO: as respostas vêm por ordem)
+    std::vector<Clock::time_point> sent_at(opt.depth);
+    std::uint64_t sent = 0;
+    std::uint64_t received = 0;
+    std::size_t next_board = offset % boards.size();
+    char frame[RESPONSE_FRAME_SIZE];
+
+    auto can_send = [&] {
+        return sent - received < opt.depth &&
+               (opt.seconds > 0 ? !stop.load(std::memory_order_relaxed) : sent < quota);
+    };
+
+    while (can_send() || received < sent) {
+        while (can_send()) {
+            encode_request(boards[next_board], frame);
+            next_board = (next_board + 1) % boards.size();
+            sent_at[sent % opt.depth] = Clock::now();
+            if (send_all(fd, frame, REQUEST_FRAME_SIZE) != 0) {
+                result.error = true;
+                close(fd);
+                return;
+            }
+            sent++;
+        }
+
+        if (recv_all(fd, frame, RESPONSE_FRAME_SIZE) != 0) {
+            result.error = true;
+            break;
+        }
+        result.latencies_ns.push_back(elapsed_ns(sent_at[received % opt.depth], Clock::now()));
+        received++;
+    }
+
+    close(fd);
+}
+
+static double percentile_us(const std::vector<std::uint64_t>& sorted, double p) {
+    std::size_t idx = static_cast<std::size_t>(p / 100.0 * double(sorted.size() - 1) + 0.5);
+    return double(sorted[idx]) / 1e3;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr,
+                     "Usage: %s [--socket PATH] [--connections C] [--depth D] "
+                     "[--requests N | --seconds S] <boards_file>\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Board> boards;
+    if (load_boards(opt.in_path, boards) != 0 || boards.empty()) {
+        std::fprintf(stderr, "Error reading file: %s\n", opt.in_path);
+        return 1;
+    }
+
+    std::vector<ConnResult> results(opt.connections);
+    std::vector<std::thread> threads;
+    std::atomic<bool> stop{false};
+
+    auto start = Clock::now();
+
+    for (unsigned c = 0; c < opt.connections; c++) {
+        std::uint64_t quota = opt.requests / opt.connections +
+                              (c < opt.requests % opt.connections ? 1 : 0);
+        // Cada ligação começa num tabuleiro diferente
+        unsigned offset = static_cast<unsigned>(c * (boards.size() / opt.connections + 1));
+        threads.emplace_back(run_connection, std::cref(opt), std::cref(boards), quota,
+                             offset, std::ref(stop), std::ref(results[c]));
+    }
+
+    if (opt.seconds > 0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(opt.seconds));
+        stop.store(true);
+    }
+
+    for (std::thread& t : threads)
+        t.join();
+
+    double wall_s = double(elapsed_ns(start, Clock::now())) / 1e9;
+
+    std::vector<std::uint64_t> all;
+    bool error = false;
+    for (const ConnResult& r : results) {
+        all.insert(all.end(), r.latencies_ns.begin(), r.latencies_ns.end());
+        error = error || r.error;
+    }
+
+    if (error)
+        std::fprintf(stderr, "Warning: some connections failed (is the server running on %s?)\n",
+                     opt.socket_path);
+    if (all.empty())
+        return 1;
+
+    std::sort(all.begin(), all.end());
+
+    double sum = 0;
+    for (std::uint64_t ns : all)
+        sum += double(ns);
+
+    std::printf("Load generator report\n");
+    std::printf("-----------------------------\n");
+    std::printf("Connections : %u\n", opt.connections);
+    std::printf("Depth       : %zu requests in flight per connection\n", opt.depth);
+    std::printf("Requests    : %zu\n", all.size());
+    std::printf("Wall time   : %.3f s\n", wall_s);
+    std::printf("Throughput  : %.0f requests/s\n\n", double(all.size()) / wall_s);
+
+    std::printf("Latency (us): min %.1f, mean %.1f, p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+                double(all.front()) / 1e3, sum / double(all.size()) / 1e3,
+                percentile_us(all, 50), percentile_us(all, 90), percentile_us(all, 99),
+                percentile_us(all, 99.9), double(all.back()) / 1e3);
+
+    return error ? 1 : 0;
+}
@@ -0,0 +1,85 @@
+#include "protocol.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+void put_u32(char* out, std::uint32_t value) {
+    out[0] = static_cast<char>(value & 0xFF);
+    out[1] = static_cast<char>((value >> 8) & 0xFF);
+    out[2] = static_cast<char>((value >> 16) & 0xFF);
+    out[3] = static_cast<char>((value >> 24) & 0xFF);
+}
+
+std::uint32_t get_u32(const char* in) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(in);
+    return std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) |
+           (std::uint32_t(p[2]) << 16) | (std::uint32_t(p[3]) << 24);
+}
+
+void encode_request(const Board& board, char* out) {
+    put_u32(out, REQUEST_PAYLOAD_SIZE);
+    std::memcpy(out + FRAME_HEADER_SIZE, board.cells.data(), 81);
+}
+
+void encode_response(std::uint8_t status, const Board& board, char* out) {
+    put_u32(out, RESPONSE_PAYLOAD_SIZE);
+    out[FRAME_HEADER_SIZE] = static_cast<char>(status);
+    std::memcpy(out + FRAME_HEADER_SIZE + 1, board.cells.data(), 81);
+}
+
+int decode_response(const char* frame, Board& board) {
+    if (get_u32(frame) != RESPONSE_PAYLOAD_SIZE)
+        return -1;
+
+    std::memcpy(board.cells.data(), frame + FRAME_HEADER_SIZE + 1, 81);
+    return static_cast<unsigned char>(frame[FRAME_HEADER_SIZE]);
+}
+
+int send_all(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 1;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return 0;
+}
+
+int recv_all(int fd, char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = read(fd, data, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 1;
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return 0;
+}
+
+int connect_unix(const char* path) {
+    sockaddr_un addr{};
+    if (std::strlen(path) >= sizeof(addr.sun_path))
+        return -1;
+
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
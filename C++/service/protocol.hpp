@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../common/board.hpp"
+
+/*
+ * Protocolo do serviço (socket Unix, SOCK_STREAM).
+ *
+ * Cada mensagem é uma frame: [u32 comprimento, little-endian][payload].
+ *   Pedido   : payload de 81 bytes, as células (0 = vazia, 1-9).
+ *   Resposta : payload de 82 bytes, 1 byte de estado + as 81 células
+ *              (a solução, ou o tabuleiro original se não houver solução).
+ *
+ * Numa ligação, as respostas vêm sempre pela ordem dos pedidos, por isso
+ * o cliente pode enviar vários pedidos sem esperar (pipelining).
+ */
+
+static constexpr const char* SERVICE_DEFAULT_SOCKET = "/tmp/sudoku.sock";
+
+static constexpr std::size_t FRAME_HEADER_SIZE = 4;
+static constexpr std::size_t REQUEST_PAYLOAD_SIZE = 81;
+static constexpr std::size_t RESPONSE_PAYLOAD_SIZE = 82;
+static constexpr std::size_t REQUEST_FRAME_SIZE = FRAME_HEADER_SIZE + REQUEST_PAYLOAD_SIZE;
+static constexpr std::size_t RESPONSE_FRAME_SIZE = FRAME_HEADER_SIZE + RESPONSE_PAYLOAD_SIZE;
+
+// Payloads maiores do que isto fecham a ligação
+static constexpr std::uint32_t MAX_PAYLOAD_SIZE = 4096;
+
+enum ResponseStatus : std::uint8_t {
+    STATUS_SOLVED = 0,
+    STATUS_NO_SOLUTION = 1,
+    STATUS_BAD_REQUEST = 2 // comprimento errado ou célula fora de 0-9
+};
+
+void put_u32(char* out, std::uint32_t value);
+std::uint32_t get_u32(const char* in);
+
+/*
+ * Escreve a frame de pedido de "board" em "out" (REQUEST_FRAME_SIZE bytes).
+ */
+void encode_request(const Board& board, char* out);
+
+/*
+ * Escreve uma frame de resposta em "out" (RESPONSE_FRAME_SIZE bytes).
+ */
+void encode_response(std::uint8_t status, const Board& board, char* out);
+
+/*
+ * Lê uma frame de resposta completa ("frame" aponta para o cabeçalho).
+ * Retorna o estado, ou -1 se o comprimento não for o esperado.
+ */
+int decode_response(const char* frame, Board& board);
+
+/*
+ * write()/read() de exatamente "size" bytes num socket bloqueante.
+ * Retornam 0 em sucesso, 1 em erro ou se a ligação fechar a meio.
+ */
+int send_all(int fd, const char* data, std::size_t size);
+int recv_all(int fd, char* data, std::size_t size);
+
+/*
+ * Liga-se ao socket Unix "path". Retorna o descritor, ou -1 em erro.
+ */
+int connect_unix(const char* path);
@@ -0,0 +1,578 @@
+#include "../unoptimized/sudoku_unoptimize.hpp"
+#include "../common/mpmc_ring.hpp"
+#include "protocol.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <semaphore.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// --------------------------------------------------
+// Serviço local: socket Unix + epoll, pedidos agrupados em micro-lotes
+// para um pool de solvers (um por core).
+//
+// Thread principal (event loop):
+//   - aceita ligações e lê as frames de pedido;
+//   - no fim de cada volta do epoll, junta os pedidos que chegaram (de todas
+//     as ligações) em lotes e entrega-os aos solvers;
+//   - recebe os lotes resolvidos e escreve as respostas pela ordem dos
+//     pedidos de cada ligação.
+// Solvers: esperam num semáforo (não gastam CPU em idle), resolvem o lote
+// e acordam o event loop através de um eventfd.
+//
+// Uso: ./server_<solver>.exe [--socket PATH] [--threads N] [--batch B]
+// Termina com SIGINT/SIGTERM.
+
+struct Request {
+    std::uint64_t conn_id = 0;
+    std::uint64_t seq = 0;
+    std::uint8_t status = STATUS_SOLVED;
+    Board board;
+};
+
+struct Batch {
+    std::size_t count = 0;
+    std::vector<Request> reqs;
+};
+
+// Máximo de pedidos por responder numa ligação; acima disto a ligação
+// deixa de ser lida até as respostas saírem (backpressure por cliente).
+static constexpr std::size_t MAX_CONN_INFLIGHT = 256;
+
+// Idem para respostas por enviar (cliente que não lê o socket)
+static constexpr std::size_t MAX_CONN_OUT = 1 << 20;
+
+static constexpr std::size_t READ_CHUNK = 64 * 1024;
+static constexpr int MAX_EVENTS = 64;
+
+// Tags do epoll; as ligações usam ids a partir de FIRST_CONN_ID
+static constexpr std::uint64_t LISTEN_TAG = 0;
+static constexpr std::uint64_t WAKE_TAG = 1;
+static constexpr std::uint64_t SIGNAL_TAG = 2;
+static constexpr std::uint64_t FIRST_CONN_ID = 16;
+
+struct Connection {
+    std::uint64_t id = 0;
+    int fd = -1;
+    std::vector<char> in;        // bytes recebidos ainda por processar
+    std::size_t in_pos = 0;
+    std::vector<char> out;       // respostas por enviar
+    std::size_t out_pos = 0;
+    std::uint64_t next_seq = 0;  // seq do próximo pedido
+    std::uint64_t next_out = 0;  // seq da próxima resposta a enviar
+    std::vector<Request> window; // respostas prontas, em window[seq % MAX_CONN_INFLIGHT]
+    std::vector<bool> ready;
+    bool peer_closed = false;
+    bool registered = false;     // está no epoll?
+    std::uint32_t events = 0;    // interesse registado no epoll
+};
+
+struct Options {
+    const char* socket_path = SERVICE_DEFAULT_SOCKET;
+    unsigned threads = 0;
+    std::size_t batch = 64;
+};
+
+struct ServiceStats {
+    std::uint64_t connections = 0;
+    std::uint64_t requests = 0;
+    std::uint64_t bad_requests = 0;
+    std::uint64_t batches = 0;
+    std::uint64_t solved = 0;
+};
+
+class SolverService {
+public:
+    explicit SolverService(const Options& opt)
+        : opt_(opt),
+          pool_(4 * opt.threads),
+          work_ring_(4 * opt.threads),
+          done_ring_(4 * opt.threads) {
+        for (Batch& b : pool_) {
+            b.reqs.resize(opt.batch);
+            free_.push_back(&b);
+        }
+        sem_init(&work_sem_, 0, 0);
+    }
+
+    ~SolverService() { sem_destroy(&work_sem_); }
+
+    int run();
+    const ServiceStats& stats() const { return stats_; }
+
+private:
+    int setup();
+    void worker_loop();
+
+    void accept_all();
+    void on_readable(Connection& c);
+    void on_writable(Connection& c);
+    void process_input(Connection& c);
+    void emit_ready(Connection& c);
+    void update(std::uint64_t id);
+    void close_conn(std::uint64_t id);
+
+    void collect_done();
+    void dispatch_pending();
+
+    static std::size_t inflight(const Connection& c) { return c.next_seq - c.next_out; }
+
+    Options opt_;
+    int listen_fd_ = -1;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    int signal_fd_ = -1;
+
+    std::vector<Batch> pool_;
+    std::vector<Batch*> free_;   // só o event loop mexe nesta lista
+    MpmcRing<Batch*> work_ring_;
+    MpmcRing<Batch*> done_ring_;
+    sem_t work_sem_;
+
+    std::unordered_map<std::uint64_t, Connection> conns_;
+    std::uint64_t next_conn_id_ = FIRST_CONN_ID;
+    std::deque<Request> pending_;
+    std::vector<std::uint64_t> touched_;
+
+    ServiceStats stats_;
+};
+
+int SolverService::setup() {
+    // SIGINT/SIGTERM passam a chegar pelo signalfd; as threads criadas depois
+    // herdam a máscara.
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    if (sigprocmask(SIG_BLOCK, &mask, nullptr) != 0)
+        return 1;
+    std::signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un addr{};
+    if (std::strlen(opt_.socket_path) >= sizeof(addr.sun_path))
+        return 1;
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, opt_.socket_path);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0)
+        return 1;
+
+    unlink(opt_.socket_path);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listen_fd_, SOMAXCONN) != 0)
+        return 1;
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    signal_fd_ = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (epoll_fd_ < 0 || wake_fd_ < 0 || signal_fd_ < 0)
+        return 1;
+
+    const int fds[] = {listen_fd_, wake_fd_, signal_fd_};
+    const std::uint64_t tags[] = {LISTEN_TAG, WAKE_TAG, SIGNAL_TAG};
+    for (int i = 0; i < 3; i++) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = tags[i];
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fds[i], &ev) != 0)
+            return 1;
+    }
+    return 0;
+}
+
+void SolverService::worker_loop() {
+    for (;;) {
+        while (sem_wait(&work_sem_) != 0 && errno == EINTR) {
+        }
+
+        // Semáforo sem lote na fila = pedido para terminar
+        Batch* b;
+        if (!work_ring_.try_pop(b))
+            return;
+
+        for (std::size_t i = 0; i < b->count; i++) {
+            Request& r = b->reqs[i];
+            Board solution;
+            if (solve(r.board, solution) == 1) {
+                r.board = solution;
+                r.status = STATUS_SOLVED;
+            } else {
+                r.status = STATUS_NO_SOLUTION;
+            }
+        }
+
+        done_ring_.push(b);
+
+        std::uint64_t one = 1;
+        ssize_t n = write(wake_fd_, &one, sizeof(one));
+        (void)n; // só falha se o contador transbordar, e aí o loop já está acordado
+    }
+}
+
+void SolverService::accept_all() {
+    for (;;) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return; // EAGAIN, ou erro transitório (EMFILE, ...): tenta na próxima volta
+
+        std::uint64_t id = next_conn_id_++;
+        Connection& c = conns_[id];
+        c.id = id;
+        c.fd = fd;
+        c.window.resize(MAX_CONN_INFLIGHT);
+        c.ready.assign(MAX_CONN_INFLIGHT, false);
+        c.events = EPOLLIN;
+        c.registered = true;
+
+        epoll_event ev{};
+        ev.events = c.events;
+        ev.data.u64 = id;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close(fd);
+            conns_.erase(id);
+            continue;
+        }
+        stats_.connections++;
+    }
+}
+
+void SolverService::on_readable(Connection& c) {
+    char chunk[READ_CHUNK];
+    for (;;) {
+        ssize_t n = read(c.fd, chunk, sizeof(chunk));
+        if (n > 0) {
+            c.in.insert(c.in.end(), chunk, chunk + n);
+            if (static_cast<std::size_t>(n) < sizeof(chunk))
+                break;
+        } else if (n == 0) {
+            c.peer_closed = true;
+            break;
+        } else {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                c.peer_closed = true;
+            break;
+        }
+    }
+    process_input(c);
+}
+
+// Converte as frames completas em pedidos, até ao limite de pedidos em curso
+void SolverService::process_input(Connection& c) {
+    while (c.in.size() - c.in_pos >= FRAME_HEADER_SIZE &&
+           inflight(c) < MAX_CONN_INFLIGHT &&
+           c.out.size() - c.out_pos < MAX_CONN_OUT) {
+        const char* frame = c.in.data() + c.in_pos;
+        std::uint32_t len = get_u32(frame);
+
+        if (len > MAX_PAYLOAD_SIZE) {
+            // Stream inválido: não há forma de voltar a sincronizar
+            c.peer_closed = true;
+            c.in.clear();
+            c.in_pos = 0;
+            return;
+        }
+        if (c.in.size() - c.in_pos < FRAME_HEADER_SIZE + len)
+            break;
+
+        Request r;
+        r.conn_id = c.id;
+        r.seq = c.next_seq++;
+        stats_.requests++;
+
+        bool valid = len == REQUEST_PAYLOAD_SIZE;
+        if (valid) {
+            std::memcpy(r.board.cells.data(), frame + FRAME_HEADER_SIZE, 81);
+            for (std::uint8_t v : r.board.cells)
+                valid = valid && v <= 9;
+        }
+
+        if (valid) {
+            pending_.push_back(r);
+        } else {
+            // Responde já, sem passar pelos solvers (mas na ordem certa)
+            r.status = STATUS_BAD_REQUEST;
+            c.window[r.seq % MAX_CONN_INFLIGHT] = r;
+            c.ready[r.seq % MAX_CONN_INFLIGHT] = true;
+            stats_.bad_requests++;
+        }
+
+        c.in_pos += FRAME_HEADER_SIZE + len;
+    }
+
+    // Compacta o buffer de entrada quando já foi quase todo consumido
+    if (c.in_pos > 0 && c.in_pos * 2 >= c.in.size()) {
+        c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(c.in_pos));
+        c.in_pos = 0;
+    }
+}
+
+// Passa as respostas que já estão em ordem para o buffer de saída
+void SolverService::emit_ready(Connection& c) {
+    while (c.next_out < c.next_seq && c.ready[c.next_out % MAX_CONN_INFLIGHT]) {
+        std::size_t slot = c.next_out % MAX_CONN_INFLIGHT;
+        const Request& r = c.window[slot];
+
+        std::size_t pos = c.out.size();
+        c.out.resize(pos + RESPONSE_FRAME_SIZE);
+        encode_response(r.status, r.board, c.out.data() + pos);
+
+        c.ready[slot] = false;
+        c.next_out++;
+    }
+}
+
+void SolverService::on_writable(Connection& c) {
+    while (c.out_pos < c.out.size()) {
+        ssize_t n = send(c.fd, c.out.data() + c.out_pos, c.out.size() - c.out_pos, MSG_NOSIGNAL);
+        if (n > 0) {
+            c.out_pos += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                // Cliente desapareceu: descarta o resto
+                c.peer_closed = true;
+                c.out.clear();
+                c.out_pos = 0;
+            }
+            break;
+        }
+    }
+
+    if (c.out_pos == c.out.size()) {
+        c.out.clear();
+        c.out_pos = 0;
+    }
+}
+
+// Depois de qualquer mudança numa ligação: as respostas prontas são
+// enviadas, e o interesse no epoll é ajustado (ou a ligação é fechada).
+void SolverService::update(std::uint64_t id) {
+    auto it = conns_.find(id);
+    if (it == conns_.end())
+        return;
+    Connection& c = it->second;
+
+    emit_ready(c);
+    on_writable(c);
+    process_input(c); // o backpressure pode ter aliviado
+    emit_ready(c);
+    on_writable(c);
+
+    bool done = c.peer_closed && inflight(c) == 0 && c.out_pos == c.out.size();
+    if (done) {
+        close_conn(id);
+        return;
+    }
+
+    bool can_read = !c.peer_closed && inflight(c) < MAX_CONN_INFLIGHT &&
+                    c.out.size() - c.out_pos < MAX_CONN_OUT;
+    std::uint32_t want = (can_read ? EPOLLIN : 0u) | (c.out_pos < c.out.size() ? EPOLLOUT : 0u);
+
+    // Sem interesse nenhum sai do epoll: EPOLLHUP é sempre reportado e,
+    // com o cliente fechado, acordaria o loop até os lotes em curso voltarem.
+    if (want == 0) {
+        if (c.registered)
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, c.fd, nullptr);
+        c.registered = false;
+    } else if (want != c.events || !c.registered) {
+        epoll_event ev{};
+        ev.events = want;
+        ev.data.u64 = id;
+        epoll_ctl(epoll_fd_, c.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, c.fd, &ev);
+        c.registered = true;
+    }
+    c.events = want;
+}
+
+void SolverService::close_conn(std::uint64_t id) {
+    auto it = conns_.find(id);
+    if (it == conns_.end())
+        return;
+
+    if (it->second.registered)
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    close(it->second.fd);
+    conns_.erase(it); // lotes ainda em curso desta ligação são descartados em collect_done
+}
+
+void SolverService::collect_done() {
+    std::uint64_t counter;
+    ssize_t n = read(wake_fd_, &counter, sizeof(counter));
+    (void)n;
+
+    Batch* b;
+    while (done_ring_.try_pop(b)) {
+        for (std::size_t i = 0; i < b->count; i++) {
+            const Request& r = b->reqs[i];
+            if (r.status == STATUS_SOLVED)
+                stats_.solved++;
+
+            auto it = conns_.find(r.conn_id);
+            if (it == conns_.end())
+                continue;
+
+            Connection& c = it->second;
+            c.window[r.seq % MAX_CONN_INFLIGHT] = r;
+            c.ready[r.seq % MAX_CONN_INFLIGHT] = true;
+            touched_.push_back(r.conn_id);
+        }
+        free_.push_back(b);
+    }
+}
+
+// Micro-batching: os pedidos pendentes são divididos pelos solvers.
+// Com pouca carga cada lote leva 1 pedido (latência mínima); com muita,
+// os lotes enchem até --batch e o custo por lote dilui-se.
+void SolverService::dispatch_pending() {
+    while (!pending_.empty() && !free_.empty()) {
+        std::size_t per_batch = (pending_.size() + opt_.threads - 1) / opt_.threads;
+        if (per_batch > opt_.batch)
+            per_batch = opt_.batch;
+
+        Batch* b = free_.back();
+        free_.pop_back();
+
+        b->count = 0;
+        while (b->count < per_batch && !pending_.empty()) {
+            b->reqs[b->count++] = pending_.front();
+            pending_.pop_front();
+        }
+
+        stats_.batches++;
+        work_ring_.push(b); // nunca bloqueia: a fila tem lugar para o pool inteiro
+        sem_post(&work_sem_);
+    }
+}
+
+int SolverService::run() {
+    if (setup() != 0) {
+        std::perror("setup");
+        return 1;
+    }
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < opt_.threads; w++)
+        workers.emplace_back([this] { worker_loop(); });
+
+    std::fprintf(stderr, "Listening on %s (%u solver threads, batch <= %zu)\n",
+                 opt_.socket_path, opt_.threads, opt_.batch);
+
+    epoll_event events[MAX_EVENTS];
+    bool running = true;
+
+    while (running) {
+        int n = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            std::uint64_t tag = events[i].data.u64;
+
+            if (tag == LISTEN_TAG) {
+                accept_all();
+            } else if (tag == WAKE_TAG) {
+                collect_done();
+            } else if (tag == SIGNAL_TAG) {
+                running = false;
+            } else {
+                auto it = conns_.find(tag);
+                if (it == conns_.end())
+                    continue;
+
+                Connection& c = it->second;
+                if (events[i].events & (EPOLLERR | EPOLLHUP))
+                    c.peer_closed = true;
+                if (events[i].events & EPOLLIN)
+                    on_readable(c);
+                if (events[i].events & EPOLLOUT)
+                    on_writable(c);
+                touched_.push_back(tag);
+            }
+        }
+
+        for (std::uint64_t id : touched_)
+            update(id);
+        touched_.clear();
+
+        dispatch_pending();
+    }
+
+    for (unsigned w = 0; w < opt_.threads; w++)
+        sem_post(&work_sem_);
+    for (std::thread& t : workers)
+        t.join();
+
+    for (auto& kv : conns_)
+        close(kv.second.fd);
+    conns_.clear();
+
+    close(signal_fd_);
+    close(wake_fd_);
+    close(epoll_fd_);
+    close(listen_fd_);
+    unlink(opt_.socket_path);
+    return 0;
+}
+
+static bool parse_options(int argc, char* argv[], Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc)
+            opt.socket_path = argv[++i];
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            opt.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+            opt.batch = static_cast<std::size_t>(std::atol(argv[++i]));
+        else
+            return false;
+    }
+
+    if (opt.threads == 0)
+        opt.threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    if (opt.batch == 0)
+        opt.batch = 1;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        std::fprintf(stderr, "Usage: %s [--socket PATH] [--threads N] [--batch B]\n", argv[0]);
+        return 1;
+    }
+
+    SolverService service(opt);
+    int err = service.run();
+
+    const ServiceStats& s = service.stats();
+    std::fprintf(stderr,
+                 "Connections: %llu, requests: %llu (bad %llu), solved: %llu\n"
+                 "Batches    : %llu (%.1f requests/batch)\n",
+                 static_cast<unsigned long long>(s.connections),
+                 static_cast<unsigned long long>(s.requests),
+                 static_cast<unsigned long long>(s.bad_requests),
+                 static_cast<unsigned long long>(s.solved),
+                 static_cast<unsigned long long>(s.batches),
+                 s.batches ? double(s.requests - s.bad_requests) / double(s.batches) : 0.0);
+    return err;
+}
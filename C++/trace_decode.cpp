@@ -0,0 +1,230 @@
+#include "common/search_trace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <queue>
+#include <vector>
+
+// --------------------------------------------------
+// Resumo de um ficheiro gravado pelos solvers compilados com TRACE=1
+// (formato em common/search_trace.hpp).
+//
+// Por nível da procura:
+//   decisões (células escolhidas), valores tentados, tamanho médio do
+//   domínio da célula escolhida, ramificação efetiva (tentados / decisões)
+//   e percentagem de tentativas que falharam.
+// Depois, as --top subárvores falhadas com mais nós (onde o solver perdeu
+// mais tempo): solve, nível, célula, valor e número de nós.
+//
+// Uso: ./trace_decode.exe [--top K] [ficheiro]   (sudoku_trace.bin por omissão)
+
+static const char* ENGINE_NAMES[] = {"unoptimized", "bitmasking", "bitmasking_fc", "dlx",
+                                     "hybrid"};
+
+struct LevelStats {
+    std::uint64_t decisions = 0;
+    std::uint64_t tries = 0;
+    std::uint64_t fails = 0;
+    std::uint64_t domain_sum = 0; // candidatos da célula na primeira tentativa
+};
+
+struct FailedSubtree {
+    std::uint32_t thread;
+    std::uint32_t solve; // n-ésimo solve dessa thread
+    std::uint8_t engine;
+    std::uint8_t depth;
+    std::uint8_t cell;
+    std::uint8_t value;
+    std::uint64_t nodes; // tentativas dentro da subárvore, incluindo a raiz
+
+    bool operator>(const FailedSubtree& o) const { return nodes > o.nodes; }
+};
+
+struct Summary {
+    std::vector<LevelStats> levels;
+    std::uint64_t events = 0;
+    std::uint64_t solves = 0;
+    std::uint64_t solved = 0;
+    std::uint64_t engine_solves[5] = {};
+
+    // Min-heap com as K maiores subárvores falhadas
+    std::size_t top = 10;
+    std::priority_queue<FailedSubtree, std::vector<FailedSubtree>, std::greater<FailedSubtree>>
+        worst;
+
+    void keep(const FailedSubtree& f) {
+        if (worst.size() < top) {
+            worst.push(f);
+        } else if (top > 0 && f.nodes > worst.top().nodes) {
+            worst.pop();
+            worst.push(f);
+        }
+    }
+};
+
+// Tentativa ainda aberta (a subárvore por baixo está a ser explorada)
+struct Frame {
+    std::uint8_t cell;
+    std::uint8_t value;
+    std::uint64_t tries_at_start;
+};
+
+// Os eventos de uma thread, pela ordem em que foram gravados
+static void decode_thread(std::uint32_t thread, const std::vector<TraceEvent>& events,
+                          Summary& sum) {
+    std::vector<Frame> stack;
+    std::uint64_t tries = 0;
+    std::uint32_t solve = 0;
+    std::uint8_t engine = 0;
+    const TraceEvent* prev = nullptr;
+
+    for (const TraceEvent& e : events) {
+        if (sum.levels.size() <= e.depth)
+            sum.levels.resize(e.depth + 1u);
+
+        switch (e.outcome) {
+        case TRACE_BEGIN:
+            stack.clear();
+            solve++;
+            engine = e.value < 5 ? e.value : 0;
+            sum.solves++;
+            sum.engine_solves[engine]++;
+            break;
+
+        case TRACE_TRY: {
+            LevelStats& lv = sum.levels[e.depth];
+            // Depois de um FAIL no mesmo nível só pode vir o valor seguinte
+            // da mesma decisão (no DLX pode ser outra célula da coluna)
+            bool sibling = prev && prev->outcome == TRACE_FAIL && prev->depth == e.depth;
+            if (!sibling) {
+                lv.decisions++;
+                lv.domain_sum += e.candidates + 1u;
+            }
+            lv.tries++;
+            tries++;
+            stack.push_back({e.cell, e.value, tries});
+            break;
+        }
+
+        case TRACE_FAIL:
+            sum.levels[e.depth].fails++;
+            if (!stack.empty()) {
+                Frame f = stack.back();
+                stack.pop_back();
+                sum.keep({thread, solve, engine, e.depth, f.cell, f.value,
+                          tries - f.tries_at_start + 1});
+            }
+            break;
+
+        case TRACE_SOLVED:
+            sum.solved++;
+            stack.clear();
+            break;
+        }
+        prev = &e;
+    }
+}
+
+static int read_trace(const char* path, std::map<std::uint32_t, std::vector<TraceEvent>>& threads,
+                      std::uint64_t& events) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f)
+        return 1;
+
+    TraceChunkHeader h;
+    int rc = 0;
+    while (std::fread(&h, sizeof(h), 1, f) == 1) {
+        if (std::memcmp(h.magic, "STRC", 4) != 0) {
+            rc = 1;
+            break;
+        }
+        std::vector<TraceEvent>& v = threads[h.thread];
+        std::size_t old = v.size();
+        v.resize(old + h.count);
+        if (std::fread(v.data() + old, sizeof(TraceEvent), h.count, f) != h.count) {
+            rc = 1;
+            break;
+        }
+        events += h.count;
+    }
+
+    std::fclose(f);
+    return rc;
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = "sudoku_trace.bin";
+    Summary sum;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            sum.top = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else if (std::strncmp(argv[i], "--", 2) == 0) {
+            std::fprintf(stderr, "Usage: %s [--top K] [trace_file]\n", argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    std::map<std::uint32_t, std::vector<TraceEvent>> threads;
+    if (read_trace(path, threads, sum.events) != 0) {
+        std::fprintf(stderr, "Error reading trace: %s\n", path);
+        return 1;
+    }
+
+    for (const auto& t : threads)
+        decode_thread(t.first, t.second, sum);
+
+    std::printf("Trace      : %s\n", path);
+    std::printf("Events     : %llu from %zu thread(s)\n",
+                static_cast<unsigned long long>(sum.events), threads.size());
+    std::printf("Solves     : %llu (%llu solved)",
+                static_cast<unsigned long long>(sum.solves),
+                static_cast<unsigned long long>(sum.solved));
+    for (int e = 0; e < 5; e++) {
+        if (sum.engine_solves[e])
+            std::printf(", %s %llu", ENGINE_NAMES[e],
+                        static_cast<unsigned long long>(sum.engine_solves[e]));
+    }
+    std::printf("\n\n");
+
+    std::printf("%5s %12s %12s %8s %10s %8s\n", "depth", "decisions", "tries", "domain",
+                "branching", "fail%");
+    for (std::size_t d = 0; d < sum.levels.size(); d++) {
+        const LevelStats& lv = sum.levels[d];
+        if (lv.tries == 0)
+            continue;
+        std::printf("%5zu %12llu %12llu %8.2f %10.2f %7.1f%%\n", d,
+                    static_cast<unsigned long long>(lv.decisions),
+                    static_cast<unsigned long long>(lv.tries),
+                    lv.decisions ? double(lv.domain_sum) / double(lv.decisions) : 0.0,
+                    lv.decisions ? double(lv.tries) / double(lv.decisions) : 0.0,
+                    100.0 * double(lv.fails) / double(lv.tries));
+    }
+
+    std::vector<FailedSubtree> worst;
+    while (!sum.worst.empty()) {
+        worst.push_back(sum.worst.top());
+        sum.worst.pop();
+    }
+    std::reverse(worst.begin(), worst.end());
+
+    if (!worst.empty()) {
+        std::printf("\nLargest failed subtrees\n");
+        std::printf("%-14s %6s %8s %5s %6s %5s %10s\n", "engine", "thread", "solve", "depth",
+                    "cell", "value", "nodes");
+    }
+    for (const FailedSubtree& f : worst) {
+        char cell[8];
+        std::snprintf(cell, sizeof(cell), "r%dc%d", f.cell / 9 + 1, f.cell % 9 + 1);
+        std::printf("%-14s %6u %8u %5u %6s %5u %10llu\n", ENGINE_NAMES[f.engine], f.thread,
+                    f.solve, f.depth, cell, f.value, static_cast<unsigned long long>(f.nodes));
+    }
+    return 0;
+}
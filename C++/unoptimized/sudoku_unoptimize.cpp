@@ -1,8 +1,6 @@
 #include "sudoku_unoptimize.hpp"
 #include "../common/board.hpp"
-
-#include <fstream>
-#include <iostream>
+#include "../common/search_trace.hpp"
 
 // Função auxiliar propositadamente má (impede otimizações)
 static std::uint8_t get_cell(const Board& board, int index) {
@@ -53,10 +51,22 @@ static int is_valid(const Board& board, int row, int col, std::uint8_t value) {
     return 1;
 }
 
+#ifdef SUDOKU_TRACE
+// Para o tracer: valores depois de "value" que ainda são válidos em (row, col),
+// como o popcount dos candidatos nos outros solvers. Só existe com TRACE=1.
+static int valid_after(const Board& board, int row, int col, std::uint8_t value) {
+    int count = 0;
+    for (std::uint8_t q = value + 1; q <= 9; ++q)
+        count += is_valid(board, row, col, q);
+    return count;
+}
+#endif
+
 // Backtracking recursivo (versão mais pesada)
 static int solve_recursive(Board& board, int row, int col) {
 
     if (row == 9) {
+        SUDOKU_TRACE_SOLVED();
         return 1;
     } else {
         if (col == 9) {
@@ -70,12 +80,14 @@ static int solve_recursive(Board& board, int row, int col) {
                 for (std::uint8_t p = 1; p <= 9; ++p) {
                     if (is_valid(board, row, col, p)) {
                         board.cells[row * 9 + col] = p;
+                        SUDOKU_TRACE_TRY(idx, p, valid_after(board, row, col, p));
 
                         if (solve_recursive(board, row, col + 1)) {
                             return 1;
                         }
 
                         board.cells[row * 9 + col] = 0;
+                        SUDOKU_TRACE_FAIL(idx, p);
                     }
                 }
                 return 0;
@@ -86,46 +98,8 @@ static int solve_recursive(Board& board, int row, int col) {
 
 // --- API pública ---
 
-int read_file(Board& board, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        return 1;
-    }
-
-    int cell_index = 0;
-    char c;
-
-    while (cell_index < 81 && file.get(c)) {
-        if (c >= '0' && c <= '9') {
-            board.cells[cell_index] = static_cast<std::uint8_t>(c - '0');
-            cell_index++;
-        } else {
-            if (c == '\n' || c == '\r') {
-                // ignora
-            } else {
-                return 1;
-            }
-        }
-    }
-
-    if (cell_index == 81) {
-        return 0;
-    }
-    return 1;
-}
-
-int solve(const Board& input, Board& solution) {
+int solve_unoptimized(const Board& input, Board& solution) {
     solution = input;
+    SUDOKU_TRACE_BEGIN(TRACE_UNOPTIMIZED, input.cells.data());
     return solve_recursive(solution, 0, 0);
 }
-
-void print_board(const Board& board) {
-    for (int row = 0; row < 9; ++row) {
-        for (int col = 0; col < 9; ++col) {
-            std::cout << static_cast<int>(
-                get_cell(board, row * 9 + col)
-            );
-        }
-        std::cout << '\n';
-    }
-}
@@ -0,0 +1,56 @@
+#include "sudoku_unoptimize.hpp"
+
+#ifndef SUDOKU_LEAN
+#include <fstream>
+#include <iostream>
+#endif
+
+// Nomes genéricos read_file/solve/print_board de sudoku_unoptimize.hpp, só
+// para os executáveis com este solver sozinho (sudoku_unoptimized.exe,
+// batch_*, pipeline_*, server_*, lean_*). Os executáveis com vários solvers
+// não ligam este objeto e chamam solve_unoptimized (ver common/engines.hpp).
+
+int solve(const Board& input, Board& solution) {
+    return solve_unoptimized(input, solution);
+}
+
+#ifndef SUDOKU_LEAN
+int read_file(Board& board, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return 1;
+    }
+
+    int cell_index = 0;
+    char c;
+
+    while (cell_index < 81 && file.get(c)) {
+        if (c >= '0' && c <= '9') {
+            board.cells[cell_index] = static_cast<std::uint8_t>(c - '0');
+            cell_index++;
+        } else {
+            if (c == '\n' || c == '\r') {
+                // ignora
+            } else {
+                return 1;
+            }
+        }
+    }
+
+    if (cell_index == 81) {
+        return 0;
+    }
+    return 1;
+}
+
+void print_board(const Board& board) {
+    for (int row = 0; row < 9; ++row) {
+        for (int col = 0; col < 9; ++col) {
+            std::cout << static_cast<int>(
+                board.cells[row * 9 + col]
+            );
+        }
+        std::cout << '\n';
+    }
+}
+#endif
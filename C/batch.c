@@ -0,0 +1,410 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sudoku.h"
+#include "sudoku_registry.h"
+
+// Multi-threaded batch run of the C solvers.
+//
+// The boards file is loaded once (81-character lines or 9 rows of 9 digits,
+// '.' or '0' for empty cells, like --stream of sudoku_solver). For each
+// solver, the boards are split into one contiguous slice per thread. Every
+// thread writes only its own slice of the solution and latency arrays, so the
+// threads share nothing but the read-only input. All threads wait on a
+// barrier and the clock starts when they are released.
+//
+// Times are read with CLOCK_MONOTONIC_RAW: it cannot jump like TIME_UTC
+// (timespec_get, used by the other C benchmarks) and NTP does not slew it.
+//
+// For each solver (best of --reps runs): puzzles/s of the whole run, then
+// per thread the boards, the busy time and the latency of one solve
+// (mean, p50, p99, max). The workers only record the raw latencies: the
+// percentiles are computed, and every solution is checked, after the threads
+// are joined, outside the timed run. A solution must be valid
+// (is_solution_valid) and keep the clues of its input.
+//
+// Usage: ./sudoku_batch [--threads N] [--solver INDEX]... [--reps R] [--csv FILE] <boards file>
+
+#define MAX_THREADS 256
+#define DEFAULT_REPS 3
+
+struct ThreadResult {
+    long boards;
+    long solved;
+    long wrong;
+    long busy_ns;
+    double mean_ns;
+    long p50_ns;
+    long p99_ns;
+    long max_ns;
+};
+
+// One worker: its slice of the boards and its own scratch.
+// Aligned so that two workers never write to the same cache line.
+struct Worker {
+    _Alignas(64) pthread_t thread;
+    const struct SolverEntry* entry;
+    const struct Board* boards; // first board of the slice
+    long count;
+    struct Board* solutions;    // one entry per board of the slice
+    uint8_t* found;             // 1 if the solver returned a solution
+    long* latency_ns;
+    pthread_barrier_t* start;
+    struct ThreadResult result;
+};
+
+struct RunResult {
+    double seconds;
+    struct ThreadResult threads[MAX_THREADS];
+};
+
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+static int compare_long(const void* a, const void* b) {
+    long x = *(const long*)a;
+    long y = *(const long*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Loads every board of the file. Same rules as --stream in main.c: digits and
+ * '.' are cells, blanks and line ends are skipped, anything else is an error.
+ * Returns the boards (malloc) and their number in "count", NULL on error.
+ */
+static struct Board* load_boards(const char* path, long* count) {
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+
+    long capacity = 1024;
+    struct Board* boards = malloc(sizeof(struct Board) * (size_t)capacity);
+    long n = 0;
+    int cell = 0;
+    int c;
+
+    while (boards && (c = fgetc(f)) != EOF) {
+        if (c == '\n' || c == '\r' || c == ' ' || c == '\t')
+            continue;
+        if (!(c == '.' || (c >= '0' && c <= '9'))) {
+            free(boards);
+            boards = NULL;
+            break;
+        }
+
+        if (n == capacity) {
+            capacity *= 2;
+            struct Board* grown = realloc(boards, sizeof(struct Board) * (size_t)capacity);
+            if (!grown) {
+                free(boards);
+                boards = NULL;
+                break;
+            }
+            boards = grown;
+        }
+
+        boards[n].cells[cell++] = (uint8_t)(c == '.' ? 0 : c - '0');
+        if (cell == 81) {
+            cell = 0;
+            n++;
+        }
+    }
+    fclose(f);
+
+    if (boards && (cell != 0 || n == 0)) {
+        free(boards);
+        boards = NULL;
+    }
+    *count = n;
+    return boards;
+}
+
+static void* worker_main(void* arg) {
+    struct Worker* w = arg;
+    struct ThreadResult* r = &w->result;
+    memset(r, 0, sizeof(*r));
+
+    pthread_barrier_wait(w->start);
+
+    for (long i = 0; i < w->count; i++) {
+        // The solvers take a non-const board: each solve gets a copy
+        struct Board input = w->boards[i];
+
+        long t0 = now_ns();
+        int found = solve_entry(w->entry, &input, &w->solutions[i]);
+        long t1 = now_ns();
+
+        w->latency_ns[i] = t1 - t0;
+        w->found[i] = (uint8_t)found;
+        r->busy_ns += t1 - t0;
+        r->boards++;
+        if (found)
+            r->solved++;
+    }
+    return NULL;
+}
+
+// Mean, p50, p99 and max of one thread's latencies (sorts "latency_ns" in place)
+static void latency_stats(long* latency_ns, long count, struct ThreadResult* r) {
+    if (count == 0)
+        return;
+
+    qsort(latency_ns, (size_t)count, sizeof(long), compare_long);
+    r->mean_ns = (double)r->busy_ns / (double)count;
+    r->p50_ns = latency_ns[count / 2];
+    r->p99_ns = latency_ns[(count * 99) / 100];
+    r->max_ns = latency_ns[count - 1];
+}
+
+// A returned solution is right if it is a valid sudoku and keeps every clue of the input
+static int is_solution_of(const struct Board* input, const struct Board* solution) {
+    for (int i = 0; i < 81; i++) {
+        if (input->cells[i] != 0 && solution->cells[i] != input->cells[i])
+            return 0;
+    }
+    return is_solution_valid(solution);
+}
+
+/*
+ * One run of "entry" over all boards with "threads" threads. "solutions",
+ * "found" and "latency" have one entry per board.
+ * Exits the program if a thread cannot be started.
+ */
+static void run_once(const struct SolverEntry* entry, const struct Board* boards, long count,
+                    int threads, struct Board* solutions, uint8_t* found, long* latency,
+                    struct RunResult* out) {
+    static struct Worker workers[MAX_THREADS];
+    pthread_barrier_t start;
+    pthread_barrier_init(&start, NULL, (unsigned)threads + 1);
+
+    int started = 0;
+    for (int t = 0; t < threads; t++) {
+        long first = count * t / threads;
+        long last = count * (t + 1) / threads;
+
+        struct Worker* w = &workers[t];
+        w->entry = entry;
+        w->boards = boards + first;
+        w->count = last - first;
+        w->solutions = solutions + first;
+        w->found = found + first;
+        w->latency_ns = latency + first;
+        w->start = &start;
+
+        if (pthread_create(&w->thread, NULL, worker_main, w) != 0)
+            break;
+        started++;
+    }
+
+    if (started != threads) {
+        // The started threads are waiting on the barrier: there is no clean
+        // way to release them with fewer participants
+        fprintf(stderr, "Could not start thread %d\n", started);
+        exit(1);
+    }
+
+    pthread_barrier_wait(&start);
+    long t0 = now_ns();
+    for (int t = 0; t < threads; t++)
+        pthread_join(workers[t].thread, NULL);
+    long t1 = now_ns();
+
+    pthread_barrier_destroy(&start);
+
+    out->seconds = (double)(t1 - t0) / 1e9;
+    for (int t = 0; t < threads; t++) {
+        // Checked and summarized here, after the clock stopped
+        struct Worker* w = &workers[t];
+        for (long i = 0; i < w->count; i++) {
+            if (w->found[i] && !is_solution_of(&w->boards[i], &w->solutions[i]))
+                w->result.wrong++;
+        }
+        latency_stats(w->latency_ns, w->count, &w->result);
+        out->threads[t] = w->result;
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [--threads N] [--solver INDEX]... [--reps R] [--csv FILE] <boards file>\n"
+            "Solvers (index - title), all by default:\n",
+            program);
+    for (int i = 0; i < SOLVER_COUNT; i++)
+        fprintf(stderr, "%d - %s\n", SOLVERS[i].index, SOLVERS[i].title);
+}
+
+int main(int argc, char* argv[]) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = online > 0 ? (int)online : 1;
+    int reps = DEFAULT_REPS;
+    const char* csv_path = NULL;
+    const char* path = NULL;
+    // Each solver at most once, so SOLVER_COUNT entries are enough
+    const struct SolverEntry** selected = malloc(sizeof(*selected) * (size_t)SOLVER_COUNT);
+    int selected_count = 0;
+    if (!selected) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--solver") == 0 && i + 1 < argc) {
+            const struct SolverEntry* entry = find_solver(atoi(argv[++i]));
+            if (!entry) {
+                fprintf(stderr, "Unknown solver index: %s\n", argv[i]);
+                usage(argv[0]);
+                free(selected);
+                return 1;
+            }
+            for (int k = 0; k < selected_count; k++) {
+                if (selected[k] == entry) {
+                    fprintf(stderr, "Solver index given twice: %s\n", argv[i]);
+                    usage(argv[0]);
+                    free(selected);
+                    return 1;
+                }
+            }
+            selected[selected_count++] = entry;
+        } else if (strncmp(argv[i], "--", 2) != 0 && !path) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            free(selected);
+            return 1;
+        }
+    }
+    if (!path) {
+        usage(argv[0]);
+        free(selected);
+        return 1;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (threads > MAX_THREADS)
+        threads = MAX_THREADS;
+    if (reps < 1)
+        reps = 1;
+    if (selected_count == 0) {
+        for (int i = 0; i < SOLVER_COUNT; i++)
+            selected[selected_count++] = &SOLVERS[i];
+    }
+
+    long count = 0;
+    struct Board* boards = load_boards(path, &count);
+    if (!boards) {
+        fprintf(stderr, "Error reading boards: %s\n", path);
+        free(selected);
+        return 1;
+    }
+    if (threads > count)
+        threads = (int)count;
+
+    long* latency = malloc(sizeof(long) * (size_t)count);
+    struct Board* solutions = malloc(sizeof(struct Board) * (size_t)count);
+    uint8_t* found = malloc((size_t)count);
+    static struct RunResult run, best;
+    if (!latency || !solutions || !found) {
+        fprintf(stderr, "Out of memory\n");
+        free(found);
+        free(solutions);
+        free(latency);
+        free(boards);
+        free(selected);
+        return 1;
+    }
+
+    FILE* csv = NULL;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            fprintf(stderr, "%s: %s\n", csv_path, strerror(errno));
+            free(found);
+            free(solutions);
+            free(latency);
+            free(boards);
+            free(selected);
+            return 1;
+        }
+        fprintf(csv, "opt_index,solver,threads,thread,boards,solved,wrong,seconds,puzzles_per_s,"
+                     "mean_ns,p50_ns,p99_ns,max_ns\n");
+    }
+
+    printf("Boards     : %ld (%s)\n", count, path);
+    printf("Threads    : %d (%ld online CPUs)\n", threads, online);
+    printf("Clock      : CLOCK_MONOTONIC_RAW, best of %d runs\n\n", reps);
+
+    int any_wrong = 0;
+
+    for (int s = 0; s < selected_count; s++) {
+        const struct SolverEntry* entry = selected[s];
+
+        best.seconds = 0;
+        for (int r = 0; r < reps; r++) {
+            run_once(entry, boards, count, threads, solutions, found, latency, &run);
+            if (best.seconds == 0 || run.seconds < best.seconds)
+                best = run;
+        }
+
+        long solved = 0;
+        long wrong = 0;
+        for (int t = 0; t < threads; t++) {
+            solved += best.threads[t].solved;
+            wrong += best.threads[t].wrong;
+        }
+        any_wrong |= wrong != 0;
+
+        double rate = (double)count / best.seconds;
+        printf("%d %s (%s): %.0f puzzles/s, %.1f ms, solved %ld/%ld", entry->index, entry->name,
+               entry->title, rate, best.seconds * 1e3, solved, count);
+        if (wrong)
+            printf(", WRONG %ld", wrong);
+        printf("\n");
+
+        printf("  %-6s %8s %10s %10s %10s %10s %10s\n", "thread", "boards", "busy_ms", "mean_us",
+               "p50_us", "p99_us", "max_us");
+        for (int t = 0; t < threads; t++) {
+            const struct ThreadResult* tr = &best.threads[t];
+            printf("  %-6d %8ld %10.1f %10.2f %10.2f %10.2f %10.2f\n", t, tr->boards,
+                   (double)tr->busy_ns / 1e6, tr->mean_ns / 1e3, (double)tr->p50_ns / 1e3,
+                   (double)tr->p99_ns / 1e3, (double)tr->max_ns / 1e3);
+
+            if (csv)
+                fprintf(csv, "%d,%s,%d,%d,%ld,%ld,%ld,%.6f,%.1f,%.1f,%ld,%ld,%ld\n", entry->index,
+                        entry->name, threads, t, tr->boards, tr->solved, tr->wrong,
+                        (double)tr->busy_ns / 1e9,
+                        tr->busy_ns ? (double)tr->boards * 1e9 / (double)tr->busy_ns : 0.0,
+                        tr->mean_ns, tr->p50_ns, tr->p99_ns, tr->max_ns);
+        }
+        printf("\n");
+
+        // thread "all": the whole run (wall time of the slowest thread)
+        if (csv)
+            fprintf(csv, "%d,%s,%d,all,%ld,%ld,%ld,%.6f,%.1f,,,,\n", entry->index, entry->name,
+                    threads, count, solved, wrong, best.seconds, rate);
+    }
+
+    if (csv)
+        fclose(csv);
+    free(found);
+    free(solutions);
+    free(latency);
+    free(boards);
+    free(selected);
+
+    // 2: some solver returned a wrong solution
+    return any_wrong ? 2 : 0;
+}
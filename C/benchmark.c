@@ -2,13 +2,8 @@
 #include <stdlib.h>
 #include <time.h>
 #include "sudoku.h"
-#include "sudoku_unoptimized.h"
-#include "sudoku_optimized_v0.h"
-#include "sudoku_optimized_v1.h"
-#include "sudoku_optimized_v2.h"
 #include "sudoku_optimized_v3.h"
-#include "sudoku_optimized_v4.h"
-#include "sudoku_optimized_v5.h"
+#include "sudoku_registry.h"
 
 // Helper to get time in nanoseconds
 long get_nanos(struct timespec* start, struct timespec* end) {
@@ -149,128 +144,45 @@ void bench_read_file_dne(const char *filePath) {
     read_file(&b, filePath);
 }
 
+struct BenchBoard {
+    const char* name;
+    const char* file_name;
+};
+
+static const struct BenchBoard BOARDS[] = {
+    {"Fully Solved              ", "../boards/fully-solved.sudoku"},
+    {"Invalid Characters        ", "../boards/invalid-characters.sudoku"},
+    {"Invalid Box Collision     ", "../boards/invalid-box-collision.sudoku"},
+    {"Invalid Col Collision     ", "../boards/invalid-col-collision.sudoku"},
+    {"Invalid Row Col Collision ", "../boards/invalid-row-col-collision.sudoku"},
+    {"Invalid Row Collision     ", "../boards/invalid-row-collision.sudoku"},
+    {"Solvable 2x hard          ", "../boards/solvable-2x-hard.sudoku"},
+    {"Solvable Easy 1           ", "../boards/solvable-easy-1.sudoku"},
+    {"Solvable example 1        ", "../boards/solvable-example-1.sudoku"},
+    {"Solvable extra hard 1     ", "../boards/solvable-extra-hard-1.sudoku"},
+    {"Solvable hard 1           ", "../boards/solvable-hard-1.sudoku"},
+    {"Solvable medium 1         ", "../boards/solvable-medium-1.sudoku"},
+};
+
 int main(void) {
     const int ITERS = 100; // change this by need
-    
-
-    printf("************************ Unoptimized ************************ \n");
-
-    puts("solve_unoptimized()");
-    benchmark_runner("Fully Solved              ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/fully-solved.sudoku");
-    benchmark_runner("Invalid Characters        ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/invalid-characters.sudoku");
-    benchmark_runner("Invalid Box Collision     ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner("Invalid Col Collision     ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner("Invalid Row Col Collision ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner("Invalid Row Collision     ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner("Solvable 2x hard          ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner("Solvable Easy 1           ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner("Solvable example 1        ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/solvable-example-1.sudoku");
-    benchmark_runner("Solvable extra hard 1     ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner("Solvable hard 1           ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner("Solvable medium 1         ", ITERS, bench_test, (void*)solve_unoptimized, "../boards/solvable-medium-1.sudoku");
-
-
-    printf("************************ Single variable added ************************ \n");
-
-    puts("solve_optimized_v0()");
-    benchmark_runner("Fully Solved              ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/fully-solved.sudoku");
-    benchmark_runner("Invalid Characters        ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/invalid-characters.sudoku");
-    benchmark_runner("Invalid Box Collision     ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner("Invalid Col Collision     ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner("Invalid Row Col Collision ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner("Invalid Row Collision     ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner("Solvable 2x hard          ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner("Solvable Easy 1           ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner("Solvable example 1        ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/solvable-example-1.sudoku");
-    benchmark_runner("Solvable extra hard 1     ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner("Solvable hard 1           ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner("Solvable medium 1         ", ITERS, bench_test, (void*)solve_optimized_v0, "../boards/solvable-medium-1.sudoku");
-
-
-    printf("************************ Combined loops ************************ \n");
-
-    puts("solve_optimized_v1()");
-    benchmark_runner("Fully Solved              ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/fully-solved.sudoku");
-    benchmark_runner("Invalid Characters        ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/invalid-characters.sudoku");
-    benchmark_runner("Invalid Box Collision     ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner("Invalid Col Collision     ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner("Invalid Row Col Collision ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner("Invalid Row Collision     ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner("Solvable 2x hard          ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner("Solvable Easy 1           ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner("Solvable example 1        ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/solvable-example-1.sudoku");
-    benchmark_runner("Solvable extra hard 1     ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner("Solvable hard 1           ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner("Solvable medium 1         ", ITERS, bench_test, (void*)solve_optimized_v1, "../boards/solvable-medium-1.sudoku");
-
+    const int BOARD_COUNT = (int)(sizeof(BOARDS) / sizeof(BOARDS[0]));
 
+    // Every solver of the registry (sudoku_registry.c)
+    for (int s = 0; s < SOLVER_COUNT; s++) {
+        const struct SolverEntry* entry = &SOLVERS[s];
 
-    printf("************************ Bitmask ************************ \n");
+        printf("************************ %s ************************ \n", entry->title);
+        printf("%s()\n", entry->name);
 
-    puts("solve_optimized_v2()");
-    benchmark_runner("Fully Solved              ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/fully-solved.sudoku");
-    benchmark_runner("Invalid Characters        ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/invalid-characters.sudoku");
-    benchmark_runner("Invalid Box Collision     ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner("Invalid Col Collision     ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner("Invalid Row Col Collision ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner("Invalid Row Collision     ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner("Solvable 2x hard          ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner("Solvable Easy 1           ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner("Solvable example 1        ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/solvable-example-1.sudoku");
-    benchmark_runner("Solvable extra hard 1     ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner("Solvable hard 1           ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner("Solvable medium 1         ", ITERS, bench_test, (void*)solve_optimized_v2, "../boards/solvable-medium-1.sudoku");
-
-
-    printf("************************ Cache optimizations ************************ \n");
-
-    puts("solve_optimized_v3()");
-    benchmark_runner_cache_optimized("Fully Solved              ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/fully-solved.sudoku");
-    benchmark_runner_cache_optimized("Invalid Characters        ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/invalid-characters.sudoku");
-    benchmark_runner_cache_optimized("Invalid Box Collision     ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner_cache_optimized("Invalid Col Collision     ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner_cache_optimized("Invalid Row Col Collision ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner_cache_optimized("Invalid Row Collision     ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner_cache_optimized("Solvable 2x hard          ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner_cache_optimized("Solvable Easy 1           ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner_cache_optimized("Solvable example 1        ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/solvable-example-1.sudoku");
-    benchmark_runner_cache_optimized("Solvable extra hard 1     ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner_cache_optimized("Solvable hard 1           ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner_cache_optimized("Solvable medium 1         ", ITERS, bench_test2, (void*)solve_optimized_v3, "../boards/solvable-medium-1.sudoku");
-
-    
-    printf("************************ Loop unrolling ************************ \n");
-
-    puts("solve_optimized_v4()");
-    benchmark_runner("Fully Solved              ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/fully-solved.sudoku");
-    benchmark_runner("Invalid Characters        ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/invalid-characters.sudoku");
-    benchmark_runner("Invalid Box Collision     ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner("Invalid Col Collision     ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner("Invalid Row Col Collision ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner("Invalid Row Collision     ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner("Solvable 2x hard          ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner("Solvable Easy 1           ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner("Solvable example 1        ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/solvable-example-1.sudoku");
-    benchmark_runner("Solvable extra hard 1     ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner("Solvable hard 1           ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner("Solvable medium 1         ", ITERS, bench_test, (void*)solve_optimized_v4, "../boards/solvable-medium-1.sudoku");
-
-        
-    printf("************************ Lookup table ************************ \n");
-
-    puts("solve_optimized_v5()");
-    benchmark_runner("Fully Solved              ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/fully-solved.sudoku");
-    benchmark_runner("Invalid Characters        ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/invalid-characters.sudoku");
-    benchmark_runner("Invalid Box Collision     ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/invalid-box-collision.sudoku");
-    benchmark_runner("Invalid Col Collision     ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/invalid-col-collision.sudoku");
-    benchmark_runner("Invalid Row Col Collision ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/invalid-row-col-collision.sudoku");
-    benchmark_runner("Invalid Row Collision     ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/invalid-row-collision.sudoku");
-    benchmark_runner("Solvable 2x hard          ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/solvable-2x-hard.sudoku");
-    benchmark_runner("Solvable Easy 1           ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/solvable-easy-1.sudoku");
-    benchmark_runner("Solvable example 1        ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/solvable-example-1.sudoku");
-    benchmark_runner("Solvable extra hard 1     ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/solvable-extra-hard-1.sudoku");
-    benchmark_runner("Solvable hard 1           ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/solvable-hard-1.sudoku");
-    benchmark_runner("Solvable medium 1         ", ITERS, bench_test, (void*)solve_optimized_v5, "../boards/solvable-medium-1.sudoku");
+        for (int i = 0; i < BOARD_COUNT; i++) {
+            if (entry->board_kind == BOARD_CACHE_OPTIMIZED)
+                benchmark_runner_cache_optimized(BOARDS[i].name, ITERS, bench_test2, (void*)entry->fn.cache_optimized, BOARDS[i].file_name);
+            else
+                benchmark_runner(BOARDS[i].name, ITERS, bench_test, (void*)entry->fn.row_major, BOARDS[i].file_name);
+        }
+        puts("");
+    }
 
     return 0;
-}
\ No newline at end of file
+}
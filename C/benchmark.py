@@ -11,9 +11,11 @@ CPU = "0"
 PERF_EVENTS = ["cycles", "instructions"]
 OUTCSV = "benchmark_results.csv"
 
-# Optimization indices (as in your sudoku_solver usage)
-# 0..5 = optimized variants, 6 = unoptimized
-OPT_INDICES = [6, 0, 1, 2, 3, 4, 5]
+
+def solver_indices(solver_bin: Path):
+    """Optimization indices of all solvers, from "sudoku_solver --list" (sudoku_registry.c)."""
+    out = subprocess.run([str(solver_bin), "--list"], capture_output=True, text=True, check=True).stdout
+    return [int(line.split()[0]) for line in out.splitlines() if line.strip()]
 
 
 def _digits_only(s: str) -> str:
@@ -101,7 +103,7 @@ def main():
             "instructions_max",
         ])
 
-        for idx in OPT_INDICES:
+        for idx in solver_indices(solver_bin):
             prog_name = f"{solver_bin} {idx}"
             for board in boards:
                 wall_times = []
@@ -4,19 +4,29 @@
 #include <string.h>
 #include <limits.h>
 #include <unistd.h>
+#include <errno.h>
 
 #include "sudoku.h"
-#include "sudoku_unoptimized.h"
-#include "sudoku_optimized_v0.h"
-#include "sudoku_optimized_v1.h"
-#include "sudoku_optimized_v2.h"
 #include "sudoku_optimized_v3.h"
-#include "sudoku_optimized_v4.h"
-#include "sudoku_optimized_v5.h"
+#include "sudoku_registry.h"
+#include "perf_counters.h"
+
+#ifdef WITH_LIBSUDOKU
+#include "libsudoku.h"
+#endif
 
 #define OUTCSV "benchmark_results_c.csv"
 #define ITERS  100
 
+// Hardware counters around each solver call (solver_only mode).
+// They are read in a separate pass (perf_active), so the ioctl/read calls
+// never end up in the measured times.
+// perf_open is 0 when perf_event_open is not allowed: the columns stay empty.
+static struct PerfCounters perf;
+static int perf_open = 0;
+static int perf_active = 0;
+static struct PerfSample perf_total; // sum over the iterations of one row
+
 // helper fct: nanos between two timespec
 static long get_nanos(const struct timespec* start, const struct timespec* end) {
     return (end->tv_sec - start->tv_sec) * 1000000000L + (end->tv_nsec - start->tv_nsec);
@@ -45,17 +55,49 @@ static void csv_write_row(FILE* csv,
                           int opt_index,
                           const char* board_name,
                           const char* mode,
-                          long ns_per_iter_avg)
+                          long ns_per_iter_avg,
+                          const struct PerfSample* counters,
+                          int iters)
 {
-    // program,opt_index,board,mode,ns_per_iter_avg
-    fprintf(csv, "%s,%d,%s,%s,%ld\n", program_path, opt_index, board_name, mode, ns_per_iter_avg);
+    // program,opt_index,board,mode,ns_per_iter_avg,cycles,...,llc_misses
+    fprintf(csv, "%s,%d,%s,%s,%ld", program_path, opt_index, board_name, mode, ns_per_iter_avg);
+
+    // per-iteration averages, empty if not counted
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters && counters->present[i])
+            fprintf(csv, ",%llu", (unsigned long long)(counters->values[i] / (uint64_t)iters));
+        else
+            fprintf(csv, ",");
+    }
+    fprintf(csv, "\n");
+}
+
+static void perf_begin(void) {
+    if (perf_active)
+        perf_counters_start(&perf);
+}
+
+static void perf_end(void) {
+    if (!perf_active)
+        return;
+
+    struct PerfSample sample;
+    if (perf_counters_stop(&perf, &sample) != 0)
+        return;
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        perf_total.values[i] += sample.values[i];
+        perf_total.present[i] |= sample.present[i];
+    }
 }
 
 static void bench_test(void* context, struct Board b) {
     SolverFunc solver_to_run = (SolverFunc)context;
 
     struct Board solved_board;
+    perf_begin();
     int res = solver_to_run(&b, &solved_board);
+    perf_end();
 
     if (res == 1) {
 
@@ -65,6 +107,25 @@ static void bench_test(void* context, struct Board b) {
     }
 }
 
+#ifdef WITH_LIBSUDOKU
+// Same as bench_test, for a C++ solver of libsudoku (context: sudoku_solver*)
+static void bench_test_lib(void* context, struct Board b) {
+    sudoku_solver* solver = (sudoku_solver*)context;
+
+    struct Board solved_board;
+    perf_begin();
+    int res = sudoku_solve(solver, b.cells, solved_board.cells);
+    perf_end();
+
+    if (res == SUDOKU_SOLVED) {
+
+        if (!is_solution_valid(&solved_board)) {
+            // fprintf(stderr, "fail!\n");
+        }
+    }
+}
+#endif
+
 static void benchmark_solver_csv(FILE* csv,
                                 const char* program_path,
                                 int opt_index,
@@ -93,9 +154,17 @@ static void benchmark_solver_csv(FILE* csv,
         total_nanos += get_nanos(&start, &end);
     }
 
+    memset(&perf_total, 0, sizeof(perf_total));
+    perf_active = perf_open;
+    for (int i = 0; i < iters && perf_active; i++) {
+        func(context, b);
+    }
+    perf_active = 0;
+
     const char* board_name = basename_c(filePath);
 
-    csv_write_row(csv, program_path, opt_index, board_name, "solver_only", total_nanos / iters);
+    csv_write_row(csv, program_path, opt_index, board_name, "solver_only", total_nanos / iters,
+                  &perf_total, iters);
 }
 
 static void benchmark_full_run_csv(FILE* csv,
@@ -125,7 +194,8 @@ static void benchmark_full_run_csv(FILE* csv,
     long total_nanos = get_nanos(&start, &end);
 
     const char* board_name = basename_c(filePath);
-    csv_write_row(csv, program_path, opt_index, board_name, "full_run", total_nanos / iters);
+    csv_write_row(csv, program_path, opt_index, board_name, "full_run", total_nanos / iters,
+                  NULL, iters);
 }
 
 static void benchmark_runner_csv(FILE* csv,
@@ -146,7 +216,9 @@ static void bench_test2(void* context, struct Board_CacheOptimized b) {
     SolverFuncCacheOptimized solver_to_run = (SolverFuncCacheOptimized)context;
 
     struct Board_CacheOptimized output;
+    perf_begin();
     solver_to_run(&b, &output);
+    perf_end();
 }
 
 static void benchmark_solver_cache_csv(FILE* csv,
@@ -177,8 +249,16 @@ static void benchmark_solver_cache_csv(FILE* csv,
         total_nanos += get_nanos(&start, &end);
     }
 
+    memset(&perf_total, 0, sizeof(perf_total));
+    perf_active = perf_open;
+    for (int i = 0; i < iters && perf_active; i++) {
+        func(context, b);
+    }
+    perf_active = 0;
+
     const char* board_name = basename_c(filePath);
-    csv_write_row(csv, program_path, opt_index, board_name, "solver_only", total_nanos / iters);
+    csv_write_row(csv, program_path, opt_index, board_name, "solver_only", total_nanos / iters,
+                  &perf_total, iters);
 }
 
 static void benchmark_full_run_cache_csv(FILE* csv,
@@ -208,7 +288,8 @@ static void benchmark_full_run_cache_csv(FILE* csv,
     long total_nanos = get_nanos(&start, &end);
 
     const char* board_name = basename_c(filePath);
-    csv_write_row(csv, program_path, opt_index, board_name, "full_run", total_nanos / iters);
+    csv_write_row(csv, program_path, opt_index, board_name, "full_run", total_nanos / iters,
+                  NULL, iters);
 }
 
 static void benchmark_runner_cache_csv(FILE* csv,
@@ -233,8 +314,15 @@ int main(void) {
         return 1;
     }
 
+    perf_open = perf_counters_open(&perf) == 0;
+    if (!perf_open)
+        perf_counters_explain(errno);
+
     // csv file header
-    fprintf(csv, "program,opt_index,board,mode,ns_per_iter_avg\n");
+    fprintf(csv, "program,opt_index,board,mode,ns_per_iter_avg");
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++)
+        fprintf(csv, ",%s", perf_counter_name(i));
+    fprintf(csv, "\n");
 
     // all boards are hardcoded here.
     const char* boards[] = {
@@ -255,24 +343,42 @@ int main(void) {
     // dynamically find the number of boards
     const int noBoards = (int)(sizeof(boards) / sizeof(boards[0]));
 
-    for (int i = 0; i < noBoards; i++) {
-        benchmark_runner_csv(csv, program_path, 0, boards[i], ITERS, bench_test, (void*)solve_optimized_v0);
-        benchmark_runner_csv(csv, program_path, 1, boards[i], ITERS, bench_test, (void*)solve_optimized_v1);
-        benchmark_runner_csv(csv, program_path, 2, boards[i], ITERS, bench_test, (void*)solve_optimized_v2);
-
-        // v3 is special (cache-optimized)
-        benchmark_runner_cache_csv(csv, program_path, 3, boards[i], ITERS, bench_test2, (void*)solve_optimized_v3);
-
-        benchmark_runner_csv(csv, program_path, 4, boards[i], ITERS, bench_test, (void*)solve_optimized_v4);
-        benchmark_runner_csv(csv, program_path, 5, boards[i], ITERS, bench_test, (void*)solve_optimized_v5);
+    // every solver of the registry (sudoku_registry.c), opt_index = its index
+    for (int s = 0; s < SOLVER_COUNT; s++) {
+        const struct SolverEntry* entry = &SOLVERS[s];
+
+        for (int i = 0; i < noBoards; i++) {
+            // v3 is special (cache-optimized)
+            if (entry->board_kind == BOARD_CACHE_OPTIMIZED)
+                benchmark_runner_cache_csv(csv, program_path, entry->index, boards[i], ITERS, bench_test2,
+                                           (void*)entry->fn.cache_optimized);
+            else
+                benchmark_runner_csv(csv, program_path, entry->index, boards[i], ITERS, bench_test,
+                                     (void*)entry->fn.row_major);
+        }
     }
 
-    // 6 = unoptimized
-    for (int i = 0; i < noBoards; i++) {
-        benchmark_runner_csv(csv, program_path, 6, boards[i], ITERS, bench_test, (void*)solve_unoptimized);
+#ifdef WITH_LIBSUDOKU
+    // 100 + i = C++ solver i of libsudoku (unoptimized, bitmasking, ...),
+    // timed in this process next to the C ones (sudoku_bench_csv_lib)
+    for (int e = 0; e < sudoku_engine_count(); e++) {
+        const char* name = sudoku_engine_name(e);
+        if (strncmp(name, "c_", 2) == 0)
+            continue;
+
+        sudoku_solver* solver = sudoku_solver_create(name);
+        if (!solver)
+            continue;
+        for (int i = 0; i < noBoards; i++) {
+            benchmark_runner_csv(csv, program_path, 100 + e, boards[i], ITERS, bench_test_lib, solver);
+        }
+        sudoku_solver_destroy(solver);
     }
+#endif
 
     fclose(csv);
+    if (perf_open)
+        perf_counters_close(&perf);
 
     return 0;
 }
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+import csv
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+# Compares sudoku_solver (-O3), sudoku_solver_lto and sudoku_solver_pgo
+# (see "make sudoku_solver_pgo"), solver by solver.
+#
+# Each solver runs in --stream mode on the first BOARDS boards of each tier of
+# the C++ corpus (../C++/corpus, made by ../C++/build_corpus.sh with seed 1;
+# the PGO build was trained on corpus/train, seed 2). The time is the one
+# printed by --stream, so process start and board parsing are outside of it.
+# The three builds run one after the other in each round; the best time of the
+# rounds is kept.
+#
+# Usage: python3 benchmark_pgo.py [rounds] [boards per tier]
+
+ROUNDS = 3
+BOARDS = 100
+CORPUS = Path("../C++/corpus")
+TIERS = ["easy", "minimal", "hard"]
+OUTCSV = "benchmark_pgo_results_c.csv"
+
+BUILDS = {"base": "./sudoku_solver", "lto": "./sudoku_solver_lto", "pgo": "./sudoku_solver_pgo"}
+
+
+def solver_indices(exe: str):
+    """Optimization indices of all solvers, from "sudoku_solver --list" (sudoku_registry.c)."""
+    out = subprocess.run([exe, "--list"], capture_output=True, text=True, check=True).stdout
+    return [int(line.split()[0]) for line in out.splitlines() if line.strip()]
+
+
+def load_tier(tier: str, count: int) -> bytes:
+    path = CORPUS / f"{tier}.txt"
+    if not path.exists():
+        sys.exit(f"Missing {path}: run ../C++/build_corpus.sh first")
+    lines = path.read_text().splitlines()[:count]
+    return ("\n".join(lines) + "\n").encode()
+
+
+def run_stream(exe: str, opt_idx: int, boards: bytes) -> int:
+    """Returns the microseconds reported by --stream."""
+    proc = subprocess.run(
+        [exe, "--stream", str(opt_idx)],
+        input=boards,
+        stdout=subprocess.DEVNULL,
+        stderr=subprocess.PIPE,
+    )
+    match = re.search(r"Took (\d+)", proc.stderr.decode(errors="replace"))
+    if proc.returncode != 0 or not match:
+        sys.exit(f"{exe} --stream {opt_idx} failed")
+    return int(match.group(1))
+
+
+def main():
+    rounds = int(sys.argv[1]) if len(sys.argv) > 1 else ROUNDS
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else BOARDS
+
+    subprocess.run(["make", "-s", "sudoku_solver", "sudoku_solver_lto", "sudoku_solver_pgo"],
+                   check=True)
+
+    inputs = {tier: load_tier(tier, count) for tier in TIERS}
+    opt_indices = solver_indices(BUILDS["base"])
+    best = {}
+
+    for r in range(rounds):
+        print(f"Round {r + 1}/{rounds}", file=sys.stderr)
+        for build, exe in BUILDS.items():
+            for opt_idx in opt_indices:
+                for tier in TIERS:
+                    us = run_stream(exe, opt_idx, inputs[tier])
+                    key = (build, opt_idx, tier)
+                    best[key] = min(best.get(key, us), us)
+
+    print(f"{'opt_index':>9} {'tier':<8} {'O3 us':>10} {'LTO us':>10} {'PGO us':>10} {'LTO':>8} {'PGO':>8}")
+    with open(OUTCSV, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["opt_index", "tier", "boards", "base_us", "lto_us", "pgo_us",
+                         "lto_gain_pct", "pgo_gain_pct"])
+        for opt_idx in opt_indices:
+            for tier in TIERS:
+                base, lto, pgo = (best[(b, opt_idx, tier)] for b in BUILDS)
+                # gain = how much faster than the -O3 build
+                lto_gain = (base / lto - 1) * 100 if lto else 0.0
+                pgo_gain = (base / pgo - 1) * 100 if pgo else 0.0
+                print(f"{opt_idx:>9} {tier:<8} {base:>10} {lto:>10} {pgo:>10} "
+                      f"{lto_gain:>+7.1f}% {pgo_gain:>+7.1f}%")
+                writer.writerow([opt_idx, tier, count, base, lto, pgo,
+                                 f"{lto_gain:.2f}", f"{pgo_gain:.2f}"])
+
+    print(f"\nSaved {OUTCSV}")
+
+
+if __name__ == "__main__":
+    main()
@@ -1,32 +1,181 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <unistd.h>
 #include "sudoku.h"
-#include "sudoku_unoptimized.h"
-#include "sudoku_optimized_v0.h"
-#include "sudoku_optimized_v1.h"
-#include "sudoku_optimized_v2.h"
-#include "sudoku_optimized_v3.h"
-#include "sudoku_optimized_v4.h"
-#include "sudoku_optimized_v5.h"
+#include "sudoku_registry.h"
 
 // Helper to get time in nanoseconds
 long get_nanos(struct timespec* start, struct timespec* end) {
     return (end->tv_sec - start->tv_sec) * 1000000000L + (end->tv_nsec - start->tv_nsec);
 }
 
+// ------------------------------------------------------------
+// --stream: boards are read from stdin until EOF, one solution per line on stdout.
+// The input can be 81-character lines or 9 rows of 9 digits (like ../boards);
+// '.' is accepted as an empty cell. Unsolved boards are echoed as they came.
+
+#define STREAM_IN_SIZE  (64 * 1024)
+#define STREAM_OUT_SIZE (64 * 1024)
+
+enum FlushMode { FLUSH_AUTO, FLUSH_BOARD, FLUSH_END };
+
+struct Stream {
+    char in[STREAM_IN_SIZE];
+    size_t in_pos;
+    size_t in_len;
+    char out[STREAM_OUT_SIZE];
+    size_t out_len;
+    enum FlushMode mode;
+};
+
+static int stream_flush(struct Stream* s) {
+    size_t done = 0;
+    while (done < s->out_len) {
+        ssize_t n = write(STDOUT_FILENO, s->out + done, s->out_len - done);
+        if (n <= 0)
+            return 1;
+        done += (size_t)n;
+    }
+    s->out_len = 0;
+    return 0;
+}
+
+/*
+ * Reads the next board. read() is only called once the buffered input is used up,
+ * and in auto mode the pending output is flushed right before that (so an
+ * interactive client gets its answer before we block).
+ * Returns 1 if a board was read, 0 on EOF, -1 on invalid input or a read error.
+ */
+static int stream_next(struct Stream* s, struct Board* board) {
+    int cell_index = 0;
+
+    for (;;) {
+        if (s->in_pos == s->in_len) {
+            if (s->mode == FLUSH_AUTO && stream_flush(s) != 0)
+                return -1;
+
+            ssize_t n = read(STDIN_FILENO, s->in, sizeof(s->in));
+            if (n < 0)
+                return -1;
+            if (n == 0)
+                return cell_index == 0 ? 0 : -1;
+
+            s->in_pos = 0;
+            s->in_len = (size_t)n;
+        }
+
+        char c = s->in[s->in_pos++];
+        if (c >= '0' && c <= '9') {
+            board->cells[cell_index++] = (uint8_t)(c - '0');
+        } else if (c == '.') {
+            board->cells[cell_index++] = 0;
+        } else if (c != '\n' && c != '\r' && c != ' ' && c != '\t') {
+            return -1;
+        }
+
+        if (cell_index == 81)
+            return 1;
+    }
+}
+
+static int stream_write(struct Stream* s, const uint8_t cells[81]) {
+    if (s->out_len + 82 > sizeof(s->out) && stream_flush(s) != 0)
+        return 1;
+
+    char* out = s->out + s->out_len;
+    for (int i = 0; i < 81; i++)
+        out[i] = (char)('0' + cells[i]);
+    out[81] = '\n';
+    s->out_len += 82;
+
+    if (s->mode == FLUSH_BOARD)
+        return stream_flush(s);
+    return 0;
+}
+
+// The solver of an optimization index; unknown indexes get the default one
+static const struct SolverEntry* solver_by_index(int optimization_index) {
+    const struct SolverEntry* entry = find_solver(optimization_index);
+    return entry ? entry : find_solver(SOLVER_INDEX_DEFAULT);
+}
+
+static int run_stream(int optimization_index, enum FlushMode mode) {
+    static struct Stream s; // 128 KB, too big for the stack
+    s.mode = mode;
+
+    const struct SolverEntry* entry = solver_by_index(optimization_index);
+
+    struct Board board;
+    Solution solution;
+    long boards = 0;
+    long solved = 0;
+    int status;
+    struct timespec start, end;
+
+    timespec_get(&start, TIME_UTC);
+
+    while ((status = stream_next(&s, &board)) == 1) {
+        int found = solve_entry(entry, &board, &solution);
+        if (found)
+            solved++;
+        boards++;
+
+        if (stream_write(&s, found ? solution.cells : board.cells) != 0)
+            return 1;
+    }
+
+    int write_err = stream_flush(&s);
+    timespec_get(&end, TIME_UTC);
+
+    fprintf(stderr, "Boards: %ld, solved: %ld. Took %ldμs\n",
+            boards, solved, get_nanos(&start, &end) / 1000);
+
+    if (status < 0) {
+        fprintf(stderr, "Invalid board in input (after %ld boards)\n", boards);
+        return 1;
+    }
+    return write_err;
+}
+
 int main(int argc, char* argv[]) {
+    // ./sudoku_solver --stream <optimization index> [--flush auto|board|end]
+    if (argc >= 3 && strcmp(argv[1], "--stream") == 0) {
+        enum FlushMode mode = FLUSH_AUTO;
+
+        if (argc >= 5 && strcmp(argv[3], "--flush") == 0) {
+            if (strcmp(argv[4], "board") == 0)
+                mode = FLUSH_BOARD;
+            else if (strcmp(argv[4], "end") == 0)
+                mode = FLUSH_END;
+            else if (strcmp(argv[4], "auto") != 0) {
+                fprintf(stderr, "Unknown flush mode: %s\n", argv[4]);
+                return 1;
+            }
+        }
+
+        return run_stream(atoi(argv[2]), mode);
+    }
+
+    // ./sudoku_solver --list: one "<index> <function> <title>" line per solver
+    if (argc >= 2 && strcmp(argv[1], "--list") == 0) {
+        for (int i = 0; i < SOLVER_COUNT; i++)
+            printf("%d %s %s\n", SOLVERS[i].index, SOLVERS[i].name, SOLVERS[i].title);
+        return 0;
+    }
+
     if (argc < 3) {
-        const char *usage = "Usage: <optimization index> <sudoku file> \n" 
-        "Optimization index can be: \n"
-        "0 - addition of a variable \n"
-        "1 - combined loops \n"
-        "2 - Bitmask \n"
-        "3 - cache optimization \n"
-        "4 - Loop unrolling \n"
-        "5 - Lookup table \n"
-        "6 - unoptimized version\n";
-        fprintf(stderr, usage);
+        fprintf(stderr, "Usage: <optimization index> <sudoku file> \n"
+                        "Optimization index can be: \n");
+        for (int i = 1; i < SOLVER_COUNT; i++)
+            fprintf(stderr, "%d - %s \n", SOLVERS[i].index, SOLVERS[i].title);
+        // the unoptimized one (the default) is listed last, like before
+        fprintf(stderr, "%d - %s\n", SOLVERS[0].index, SOLVERS[0].title);
+        fprintf(stderr, "\n"
+                        "Stream mode: --stream <optimization index> [--flush auto|board|end]\n"
+                        "(boards from stdin, one solution per line on stdout)\n"
+                        "List of solvers: --list\n");
         return 1;
     }
 
@@ -37,82 +186,45 @@ int main(int argc, char* argv[]) {
     const char* file_path = argv[2];
 
     struct Board board;
-    struct Board_CacheOptimized board_cache_optimized;
 
-    if(optimization_index == 3) { // Cache optimization - this is a special case
-        if (read_file2(&board_cache_optimized, file_path) != 0) {
-            fprintf(stderr, "Error reading file: %s\n", file_path);
-            return 1;
-        }
-    }
-    else if (read_file(&board, file_path) != 0) {
+    // One open/read/close, no stdio buffering (matters when a process is spawned per board)
+    if (read_file_raw(&board, file_path) != 0) {
         fprintf(stderr, "Error reading file: %s\n", file_path);
         return 1;
     }
 
+    const struct SolverEntry* entry = solver_by_index(optimization_index);
+
     Solution solution;
+    struct Board_CacheOptimized board_cache_optimized;
     Solution_CacheOptimized solution_cache_optimized;
     struct timespec start, end;
 
+    // Cache-optimized solvers (v3, v3_sse): the conversions are not timed, like in benchmark.c
+    if (entry->board_kind == BOARD_CACHE_OPTIMIZED)
+        board_to_cache_optimized(board.cells, &board_cache_optimized);
+
     timespec_get(&start, TIME_UTC);
 
     int found_solution;
-    switch(optimization_index)
-    {
-        case 0:
-        {
-            found_solution = solve_optimized_v0(&board, &solution);
-            break;
-        }
-        case 1:
-        {
-            found_solution = solve_optimized_v1(&board, &solution);
-            break;
-        }
-        case 2:
-        {
-            found_solution = solve_optimized_v2(&board, &solution);
-            break;
-        }
-        case 3:
-        {
-            found_solution = solve_optimized_v3(&board_cache_optimized, &solution_cache_optimized);
-            break;
-        }
-        case 4:
-        {
-            found_solution = solve_optimized_v4(&board, &solution);
-            break;
-        }
-        case 5:
-        {
-            found_solution = solve_optimized_v5(&board, &solution);
-            break;
-        }
-        default:
-        {
-            found_solution = solve_unoptimized(&board, &solution);
-            break;
-        }
-    }
-
-    // int found_solution = solve_optimized_v0(&board, &solution);
+    if (entry->board_kind == BOARD_CACHE_OPTIMIZED)
+        found_solution = entry->fn.cache_optimized(&board_cache_optimized, &solution_cache_optimized);
+    else
+        found_solution = entry->fn.row_major(&board, &solution);
 
     timespec_get(&end, TIME_UTC);
     // --- End time_it! equivalent ---
 
+    if (found_solution && entry->board_kind == BOARD_CACHE_OPTIMIZED)
+        memcpy(solution.cells, solution_cache_optimized.cells_row_major, 81);
+
     long nanos = get_nanos(&start, &end);
     long micros = nanos / 1000;
 
     if (found_solution) {
         printf("Solution:\n");
-        if(optimization_index == 3) {
-            print_board2(&solution_cache_optimized);
-        }
-        else {
-            print_board(&solution);
-        }
-        
+        print_board(&solution);
+
         printf("\nTook %ldμs\n", micros);
     } else {
         printf("No solution found. Took %ldμs\n", micros);
@@ -0,0 +1,340 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sudoku.h"
+#include "sudoku_internal.h"
+#include "sudoku_optimized_v3.h"
+
+// Microbenchmark of the is_valid kernels of each variant (sudoku_internal.h).
+//
+// The states are partial boards captured from real solves: the row-major
+// backtracking search shared by v0-v5 runs on the input boards and keeps
+// one node every "stride" nodes. Each state is queried for values 1-9 at
+// its next empty cell, which is exactly what the solvers ask there.
+// With --record the states are saved (one 81-character line per state), and
+// --states reuses them, so a change to one kernel is always compared on the
+// same inputs.
+//
+// One repetition calls the kernel for every state and value and is timed
+// as a whole. The table shows ns per call (min and median of the
+// repetitions). All kernels must give the same number of valid placements.
+//
+// Usage: ./sudoku_microbench [--states FILE | --record FILE] [--reps R] [--csv FILE] [board files...]
+
+#define MAX_STATES   4096
+#define DEFAULT_REPS 21
+
+typedef int (*IsValidFunc)(const struct Board*, int, int, uint8_t);
+
+struct State {
+    struct Board board;
+    int row;
+    int col;
+};
+
+static struct State states[MAX_STATES];
+static struct Board_CacheOptimized cache_states[MAX_STATES];
+static struct Board_Sse sse_states[MAX_STATES];
+static int state_count = 0;
+
+// Search state of one capture
+struct Capture {
+    long nodes;
+    long stride; // 0: only count the nodes
+    int limit;   // stop keeping states at this count
+};
+
+// helper fct: nanos between two timespec
+static long get_nanos(const struct timespec* start, const struct timespec* end) {
+    return (end->tv_sec - start->tv_sec) * 1000000000L + (end->tv_nsec - start->tv_nsec);
+}
+
+static int compare_long(const void* a, const void* b) {
+    long x = *(const long*)a;
+    long y = *(const long*)b;
+    return (x > y) - (x < y);
+}
+
+// Same search as solve_recursive in v0, keeping every stride-th node
+static int capture_search(struct Board* board, int row, int col, struct Capture* cap) {
+    if (row == 9)
+        return 1;
+    if (col == 9)
+        return capture_search(board, row + 1, 0, cap);
+    if (board->cells[row * 9 + col] != 0)
+        return capture_search(board, row, col + 1, cap);
+
+    if (cap->stride && cap->nodes % cap->stride == 0 && state_count < cap->limit) {
+        states[state_count].board = *board;
+        states[state_count].row = row;
+        states[state_count].col = col;
+        state_count++;
+    }
+    cap->nodes++;
+
+    for (uint8_t p = 1; p <= 9; p++) {
+        if (!sudoku_is_valid_v0(board, row, col, p))
+            continue;
+
+        board->cells[row * 9 + col] = p;
+        if (capture_search(board, row, col + 1, cap))
+            return 1;
+        board->cells[row * 9 + col] = 0;
+    }
+    return 0;
+}
+
+// Spreads MAX_STATES over the boards (a count pass, then a keep pass)
+static void capture_states(const char** files, int file_count) {
+    int per_board = MAX_STATES / file_count;
+    if (per_board < 1)
+        per_board = 1;
+
+    for (int i = 0; i < file_count && state_count < MAX_STATES; i++) {
+        struct Board input;
+        if (read_file(&input, files[i]) != 0 || !is_board_valid(&input)) {
+            fprintf(stderr, "Skipping %s (not a valid board)\n", files[i]);
+            continue;
+        }
+
+        struct Board work = input;
+        struct Capture count = {0, 0, 0};
+        capture_search(&work, 0, 0, &count);
+
+        work = input;
+        struct Capture keep = {0, count.nodes / per_board, state_count + per_board};
+        if (keep.stride < 1)
+            keep.stride = 1;
+        if (keep.limit > MAX_STATES)
+            keep.limit = MAX_STATES;
+        capture_search(&work, 0, 0, &keep);
+    }
+}
+
+// The next empty cell in row-major order, where the solvers would query
+static int set_query_cell(struct State* s) {
+    for (int i = 0; i < 81; i++) {
+        if (s->board.cells[i] == 0) {
+            s->row = i / 9;
+            s->col = i % 9;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int load_states(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f)
+        return 1;
+
+    char line[128];
+    while (state_count < MAX_STATES && fgets(line, sizeof(line), f)) {
+        struct State* s = &states[state_count];
+        int n = 0;
+        for (const char* c = line; *c && n < 81; c++) {
+            if (*c >= '0' && *c <= '9')
+                s->board.cells[n++] = (uint8_t)(*c - '0');
+            else if (*c == '.')
+                s->board.cells[n++] = 0;
+        }
+        if (n == 81 && set_query_cell(s))
+            state_count++;
+    }
+
+    fclose(f);
+    return state_count > 0 ? 0 : 1;
+}
+
+static int save_states(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f)
+        return 1;
+    for (int i = 0; i < state_count; i++) {
+        for (int j = 0; j < 81; j++)
+            fputc('0' + states[i].board.cells[j], f);
+        fputc('\n', f);
+    }
+    return fclose(f) == 0 ? 0 : 1;
+}
+
+// One repetition: every state, values 1-9
+static long run_pass(IsValidFunc fn, long* valid) {
+    struct timespec start, end;
+    long ok = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < state_count; i++) {
+        const struct State* s = &states[i];
+        for (uint8_t v = 1; v <= 9; v++)
+            ok += fn(&s->board, s->row, s->col, v);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *valid = ok;
+    return get_nanos(&start, &end);
+}
+
+// Same as run_pass, for the cache-optimized board of v3
+static long run_pass_v3(long* valid) {
+    struct timespec start, end;
+    long ok = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < state_count; i++) {
+        const struct State* s = &states[i];
+        for (uint8_t v = 1; v <= 9; v++)
+            ok += sudoku_is_valid_v3(&cache_states[i], s->row, s->col, v);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *valid = ok;
+    return get_nanos(&start, &end);
+}
+
+// Same as run_pass, for the three padded layouts of v3_sse
+static long run_pass_v3_sse(long* valid) {
+    struct timespec start, end;
+    long ok = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < state_count; i++) {
+        const struct State* s = &states[i];
+        for (uint8_t v = 1; v <= 9; v++)
+            ok += sudoku_is_valid_v3_sse(&sse_states[i], s->row, s->col, v);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *valid = ok;
+    return get_nanos(&start, &end);
+}
+
+int main(int argc, char* argv[]) {
+    const char* states_path = NULL;
+    const char* record_path = NULL;
+    const char* csv_path = NULL;
+    int reps = DEFAULT_REPS;
+    const char* files[64];
+    int file_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--states") == 0 && i + 1 < argc) {
+            states_path = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (strncmp(argv[i], "--", 2) != 0 && file_count < 64) {
+            files[file_count++] = argv[i];
+        } else {
+            fprintf(stderr,
+                    "Usage: %s [--states FILE | --record FILE] [--reps R] [--csv FILE] [board files...]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (reps < 1)
+        reps = 1;
+
+    if (file_count == 0) {
+        const char* defaults[] = {
+            "../boards/solvable-2x-hard.sudoku",
+            "../boards/solvable-easy-1.sudoku",
+            "../boards/solvable-example-1.sudoku",
+            "../boards/solvable-extra-hard-1.sudoku",
+            "../boards/solvable-hard-1.sudoku",
+            "../boards/solvable-medium-1.sudoku",
+        };
+        file_count = (int)(sizeof(defaults) / sizeof(defaults[0]));
+        memcpy(files, defaults, sizeof(defaults));
+    }
+
+    if (states_path) {
+        if (load_states(states_path) != 0) {
+            fprintf(stderr, "Error reading states: %s\n", states_path);
+            return 1;
+        }
+    } else {
+        capture_states(files, file_count);
+        if (state_count == 0) {
+            fprintf(stderr, "No states captured\n");
+            return 1;
+        }
+        if (record_path && save_states(record_path) != 0) {
+            perror(record_path);
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < state_count; i++) {
+        board_to_cache_optimized(states[i].board.cells, &cache_states[i]);
+        board_to_sse(states[i].board.cells, &sse_states[i]);
+    }
+
+    struct {
+        const char* name;
+        IsValidFunc fn;            // row-major kernels
+        long (*pass)(long* valid); // the others, with their own board layout
+    } kernels[] = {
+        {"unoptimized", sudoku_is_valid_unoptimized, NULL},
+        {"v0", sudoku_is_valid_v0, NULL},
+        {"v1", sudoku_is_valid_v1, NULL},
+        {"v3", NULL, run_pass_v3},
+        {"v3_sse", NULL, run_pass_v3_sse},
+        {"v4", sudoku_is_valid_v4, NULL},
+        {"v5", sudoku_is_valid_v5, NULL},
+    };
+    const int kernel_count = (int)(sizeof(kernels) / sizeof(kernels[0]));
+
+    FILE* csv = NULL;
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            perror(csv_path);
+            return 1;
+        }
+        fprintf(csv, "kernel,states,calls,valid,min_ns_per_call,median_ns_per_call\n");
+    }
+
+    long calls = (long)state_count * 9;
+    long* samples = malloc(sizeof(long) * (size_t)reps);
+    long expected_valid = -1;
+    int mismatch = 0;
+
+    printf("States: %d (%s), %d repetitions of %ld calls\n\n", state_count,
+           states_path ? states_path : "captured", reps, calls);
+    printf("%-12s %10s %14s %14s\n", "is_valid", "valid", "min ns/call", "median ns/call");
+
+    for (int k = 0; k < kernel_count; k++) {
+        long valid = 0;
+        for (int r = 0; r < reps; r++)
+            samples[r] = kernels[k].fn ? run_pass(kernels[k].fn, &valid) : kernels[k].pass(&valid);
+        qsort(samples, (size_t)reps, sizeof(long), compare_long);
+
+        double min = (double)samples[0] / (double)calls;
+        double median = (double)samples[reps / 2] / (double)calls;
+        printf("%-12s %10ld %14.2f %14.2f\n", kernels[k].name, valid, min, median);
+        if (csv)
+            fprintf(csv, "%s,%d,%ld,%ld,%.3f,%.3f\n", kernels[k].name, state_count, calls, valid,
+                    min, median);
+
+        if (expected_valid < 0)
+            expected_valid = valid;
+        else if (valid != expected_valid)
+            mismatch = 1;
+    }
+
+    free(samples);
+    if (csv)
+        fclose(csv);
+
+    if (mismatch) {
+        fprintf(stderr, "is_valid kernels disagree on the same states\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,157 @@
+#include "perf_counters.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static const char* COUNTER_NAMES[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"
+};
+
+static void counter_attr(int id, struct perf_event_attr* attr) {
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+
+    switch (id) {
+    case PERF_CYCLES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PERF_INSTRUCTIONS:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PERF_BRANCH_MISSES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PERF_L1D_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_L1D
+                     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case PERF_LLC_MISSES:
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    }
+
+    attr->read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID
+                      | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    // Only the leader starts disabled; the others follow it
+    attr->disabled = (id == PERF_CYCLES);
+}
+
+int perf_counters_open(struct PerfCounters* pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        pc->fds[i] = -1;
+        pc->ids[i] = 0;
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+        counter_attr(i, &attr);
+
+        // pid 0, cpu -1: this thread, on any CPU
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, pc->fds[PERF_CYCLES], 0);
+        if (fd < 0) {
+            if (i == PERF_CYCLES)
+                return 1;
+            continue; // e.g. no L1d event in this VM
+        }
+
+        uint64_t id = 0;
+        if (ioctl(fd, PERF_EVENT_IOC_ID, &id) != 0) {
+            close(fd);
+            if (i == PERF_CYCLES)
+                return 1;
+            continue;
+        }
+        pc->fds[i] = fd;
+        pc->ids[i] = id;
+    }
+    return 0;
+}
+
+void perf_counters_close(struct PerfCounters* pc) {
+    // Siblings first, the leader last
+    for (int i = PERF_COUNTER_COUNT - 1; i >= 0; i--) {
+        if (pc->fds[i] >= 0)
+            close(pc->fds[i]);
+        pc->fds[i] = -1;
+    }
+}
+
+void perf_counters_start(struct PerfCounters* pc) {
+    int leader = pc->fds[PERF_CYCLES];
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+int perf_counters_stop(struct PerfCounters* pc, struct PerfSample* sample) {
+    int leader = pc->fds[PERF_CYCLES];
+    ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    memset(sample, 0, sizeof(*sample));
+
+    // nr, time_enabled, time_running, then { value, id } per counter
+    uint64_t buffer[3 + 2 * PERF_COUNTER_COUNT];
+    ssize_t n = read(leader, buffer, sizeof(buffer));
+    if (n < (ssize_t)(3 * sizeof(uint64_t)))
+        return 1;
+
+    uint64_t nr = buffer[0];
+    uint64_t enabled = buffer[1];
+    uint64_t running = buffer[2];
+    if (running == 0 || nr > PERF_COUNTER_COUNT)
+        return 1; // the group was never scheduled on the PMU
+
+    for (uint64_t k = 0; k < nr; k++) {
+        uint64_t value = buffer[3 + 2 * k];
+        uint64_t id = buffer[4 + 2 * k];
+
+        // Scale up if the group was multiplexed with other events
+        if (running < enabled)
+            value = (uint64_t)((double)value * (double)enabled / (double)running);
+
+        for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+            if (pc->fds[i] >= 0 && pc->ids[i] == id) {
+                sample->values[i] = value;
+                sample->present[i] = 1;
+            }
+        }
+    }
+    return 0;
+}
+
+const char* perf_counter_name(int id) {
+    if (id < 0 || id >= PERF_COUNTER_COUNT)
+        return "unknown";
+    return COUNTER_NAMES[id];
+}
+
+void perf_counters_explain(int err) {
+    int paranoid = -1;
+    FILE* f = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+    if (f) {
+        if (fscanf(f, "%d", &paranoid) != 1)
+            paranoid = -1;
+        fclose(f);
+    }
+
+    fprintf(stderr, "Hardware counters unavailable: %s", strerror(err));
+    if (paranoid >= 0)
+        fprintf(stderr, " (kernel.perf_event_paranoid = %d", paranoid);
+    if (paranoid > 2)
+        fprintf(stderr, ", needs <= 2");
+    if (paranoid >= 0)
+        fprintf(stderr, ")");
+    fprintf(stderr, "; continuing without them\n");
+}
@@ -0,0 +1,69 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+
+/*
+ * Hardware counters for the calling thread, read with perf_event_open.
+ *
+ * All counters are opened as one group (cycles is the leader), so they are
+ * always scheduled together and their values belong to the same interval.
+ * Only user-space events are counted (exclude_kernel), which is what
+ * kernel.perf_event_paranoid = 2 still allows for unprivileged users.
+ *
+ * Counters the CPU (or VM) does not support are skipped; if not even the
+ * cycles counter can be opened, perf_counters_open() fails and the caller
+ * simply reports no counters.
+ */
+
+enum PerfCounterId {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_COUNTER_COUNT
+};
+
+struct PerfCounters {
+    int fds[PERF_COUNTER_COUNT];      // -1 if the counter is not open
+    uint64_t ids[PERF_COUNTER_COUNT]; // kernel ids, to match the group read
+};
+
+struct PerfSample {
+    uint64_t values[PERF_COUNTER_COUNT];
+    int present[PERF_COUNTER_COUNT];  // 1 if values[i] was counted
+};
+
+/*
+ * Opens the counter group for the calling thread (disabled).
+ * Returns 0 on success, 1 if no counters are available
+ * (errno is left from the failed perf_event_open call).
+ */
+int perf_counters_open(struct PerfCounters* pc);
+
+void perf_counters_close(struct PerfCounters* pc);
+
+/*
+ * Resets and enables the whole group.
+ */
+void perf_counters_start(struct PerfCounters* pc);
+
+/*
+ * Disables the group and reads it into "sample" (values scaled if the group
+ * was multiplexed). Returns 0 on success, 1 if nothing was counted.
+ */
+int perf_counters_stop(struct PerfCounters* pc, struct PerfSample* sample);
+
+/*
+ * Short name of a counter, e.g. "cycles" or "llc_misses".
+ */
+const char* perf_counter_name(int id);
+
+/*
+ * Prints why the counters are unavailable (errno and perf_event_paranoid)
+ * to stderr.
+ */
+void perf_counters_explain(int err);
+
+#endif // PERF_COUNTERS_H
@@ -2,6 +2,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h> 
+#include <fcntl.h>
+#include <unistd.h>
+
+// 9 rows of 9 digits + "\r\n" still fit, the rest is ignored like in read_file()
+#define RAW_BUFFER_SIZE 128
 
 int read_file(struct Board* board, const char* filename) {
 
@@ -26,6 +31,33 @@ int read_file(struct Board* board, const char* filename) {
     return (cell_index == 81) ? 0 : 1;
 }
 
+int read_file_raw(struct Board* board, const char* filename) {
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return 1;
+
+    char buffer[RAW_BUFFER_SIZE];
+    ssize_t bytes_read = read(fd, buffer, sizeof(buffer));
+    close(fd);
+
+    if (bytes_read <= 0)
+        return 1;
+
+    int cell_index = 0;
+
+    for (ssize_t i = 0; i < bytes_read && cell_index < 81; i++) {
+        char c = buffer[i];
+        if (c >= '0' && c <= '9') {
+            board->cells[cell_index++] = (uint8_t)(c - '0');
+        } else if (c != '\n' && c != '\r') {
+            return 1;
+        }
+    }
+
+    return (cell_index == 81) ? 0 : 1;
+}
+
 void print_board(const struct Board* board) {
 
     const uint8_t* cells = board->cells;
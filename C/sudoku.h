@@ -25,6 +25,14 @@ typedef struct Board Solution;
  */
 int read_file(struct Board* board, const char* filename);
 
+/*
+ * Reads a Board from a file with a single open/read/close and no stdio.
+ * The whole file (9 rows of 10 chars) is read into a stack buffer and
+ * parsed in place, with the same rules as read_file().
+ * Returns 0 on success, 1 on error.
+ */
+int read_file_raw(struct Board* board, const char* filename);
+
 /**
  * Prints the board 
  */
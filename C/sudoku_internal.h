@@ -0,0 +1,27 @@
+#ifndef SUDOKU_INTERNAL_H
+#define SUDOKU_INTERNAL_H
+
+#include "sudoku.h"
+#include "sudoku_optimized_v3.h"
+#include "sudoku_optimized_v3_sse.h"
+
+/*
+ * Internal kernels of the solvers, exported only for the microbenchmarks
+ * (microbench.c). They are not part of the solver API.
+ *
+ * Each function calls the static is_valid of that variant, so it runs
+ * exactly the code the solver runs.
+ * Returns 1 if "value" can be placed at (row, col), 0 otherwise.
+ *
+ * v2 has no is_valid: its check is three mask tests inside the search loop.
+ * Neither has v6 (bitmasks too).
+ */
+int sudoku_is_valid_unoptimized(const struct Board* board, int row, int col, uint8_t value);
+int sudoku_is_valid_v0(const struct Board* board, int row, int col, uint8_t value);
+int sudoku_is_valid_v1(const struct Board* board, int row, int col, uint8_t value);
+int sudoku_is_valid_v3(const struct Board_CacheOptimized* board, int row, int col, uint8_t value);
+int sudoku_is_valid_v3_sse(const struct Board_Sse* board, int row, int col, uint8_t value);
+int sudoku_is_valid_v4(const struct Board* board, int row, int col, uint8_t value);
+int sudoku_is_valid_v5(const struct Board* board, int row, int col, uint8_t value);
+
+#endif // SUDOKU_INTERNAL_H
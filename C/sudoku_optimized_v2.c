@@ -1,36 +1,30 @@
 #include "sudoku_optimized_v2.h"
 #include "sudoku.h"
+#include "sudoku_tables.h"
 
 static int solve_recursive_bitmask(
     struct Board* board, 
-    int row, 
-    int col,
+    const uint8_t* empty,
+    int remaining,
     uint16_t rows[9], 
     uint16_t cols[9], 
     uint16_t boxes[9]
 ) {
     // Base case - success
-    // If the function is called with the row = 9, this means
-    // it has successfully completed the rows from 0 to 8, 
-    // hence, the puzzle is solved !
-    if (row == 9) {
+    // "empty" lists the cells that were empty at the start (sudoku_tables.h),
+    // from left to right and from top to bottom. When none is left,
+    // the puzzle is solved !
+    if (remaining == 0) {
         return 1;
     } 
     
-    // Navigation login
-    // From left to right and from top to bottom
-    int next_row = row;
-    int next_col = col + 1;
-    if (next_col == 9) {
-        next_row = row + 1;
-        next_col = 0;
-    }
+    // The next empty cell. The filled cells are never visited, and the
+    // row, column and box come from the tables instead of / and %
+    const int cell = empty[0];
+    const int row = g_cell_row[cell];
+    const int col = g_cell_col[cell];
+    const int box_idx = g_cell_box[cell];
 
-    if (board->cells[row * 9 + col] != 0) {
-        // The cell is already filled. Proceed to the next one
-        return solve_recursive_bitmask(board, next_row, next_col, rows, cols, boxes);
-    } 
-    
     // The cell is empty. Try all numbers
     for (uint8_t p = 1; p <= 9; p++) {
         
@@ -38,7 +32,6 @@ static int solve_recursive_bitmask(
         // The verification takes O(1) using bitmasks
         
         const uint16_t mask = 1 << (p - 1);
-        const int box_idx = (row / 3) * 3 + (col / 3);
 
         // Key optimization.
         if (!(rows[row] & mask) && // Checks if the bit for the number p is 0 on the current row is UNSET
@@ -46,20 +39,20 @@ static int solve_recursive_bitmask(
             !(boxes[box_idx] & mask)) // Checks if the bit for the number p is 0 on the current box is UNSET
         {
             // The number 'p' is valid. We set it.
-            board->cells[row * 9 + col] = p; // Put the number on the board
+            board->cells[cell] = p; // Put the number on the board
 
             // Update the masks
             rows[row] |= mask;
             cols[col] |= mask;
             boxes[box_idx] |= mask;
 
-            if (solve_recursive_bitmask(board, next_row, next_col, rows, cols, boxes)) {
+            if (solve_recursive_bitmask(board, empty + 1, remaining - 1, rows, cols, boxes)) {
                 return 1; // Solution found
             }
 
             // Placing the number p led to a deadend, hence p is wrong
             // 
-            board->cells[row * 9 + col] = 0;
+            board->cells[cell] = 0;
             rows[row] &= ~mask;
             cols[col] &= ~mask;
             boxes[box_idx] &= ~mask;
@@ -115,5 +108,8 @@ int solve_optimized_v2(struct Board* input, struct Board* solution) {
         }
     }
 
-    return solve_recursive_bitmask(solution, 0, 0, rows, cols, boxes);
+    uint8_t empty[81];
+    int empty_count = collect_empty_cells(solution, empty);
+
+    return solve_recursive_bitmask(solution, empty, empty_count, rows, cols, boxes);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "sudoku_optimized_v3.h"
+#include "sudoku_internal.h"
 
 
 static int is_valid_cache_friendly(const struct Board_CacheOptimized* board, 
@@ -117,6 +118,18 @@ int read_file2(struct Board_CacheOptimized* board, const char* filename) {
 }
 
 
+void board_to_cache_optimized(const uint8_t cells[81], struct Board_CacheOptimized* out) {
+
+    for (int row = 0; row < 9; row++) {
+        for (int col = 0; col < 9; col++) {
+            uint8_t value = cells[row * 9 + col];
+            out->cells_row_major[row * 9 + col] = value;
+            out->cells_col_major[col * 9 + row] = value;
+        }
+    }
+}
+
+
 int is_board_valid_cache_optimized(const struct Board_CacheOptimized* board) {
 
     // seen_rows[r][num] == 1 means that the number 'num' has been seen on the row 'r'
@@ -170,4 +183,9 @@ void print_board2(const struct Board_CacheOptimized* board)
 
         putchar('\n');
     }
-}
\ No newline at end of file
+}
+
+// Exported for the microbenchmarks (sudoku_internal.h)
+int sudoku_is_valid_v3(const struct Board_CacheOptimized* board, int row, int col, uint8_t value) {
+    return is_valid_cache_friendly(board, row, col, value);
+}
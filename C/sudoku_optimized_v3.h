@@ -26,6 +26,12 @@ typedef struct Board_CacheOptimized Solution_CacheOptimized;
  */
 int read_file2(struct Board_CacheOptimized* board, const char* filename);
 
+/*
+ * Fills both layouts of "out" from a row-major board
+ * (e.g. one loaded with read_file_raw()).
+ */
+void board_to_cache_optimized(const uint8_t cells[81], struct Board_CacheOptimized* out);
+
 int is_board_valid_cache_optimized(const struct Board_CacheOptimized* board);
 
 /*
@@ -0,0 +1,116 @@
+#include "sudoku_optimized_v3_sse.h"
+#include "sudoku_internal.h"
+#include "sudoku_tables.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Position of each cell inside its box (the box itself is g_cell_box, sudoku_tables.h)
+static const uint8_t g_box_pos[81] = {
+    0, 1, 2, 0, 1, 2, 0, 1, 2,
+    3, 4, 5, 3, 4, 5, 3, 4, 5,
+    6, 7, 8, 6, 7, 8, 6, 7, 8,
+    0, 1, 2, 0, 1, 2, 0, 1, 2,
+    3, 4, 5, 3, 4, 5, 3, 4, 5,
+    6, 7, 8, 6, 7, 8, 6, 7, 8,
+    0, 1, 2, 0, 1, 2, 0, 1, 2,
+    3, 4, 5, 3, 4, 5, 3, 4, 5,
+    6, 7, 8, 6, 7, 8, 6, 7, 8,
+};
+
+static int is_valid_sse(const struct Board_Sse* board, int row, int col, uint8_t value)
+{
+    const int box = g_cell_box[row * 9 + col];
+
+#ifdef __SSE2__
+    // One compare per unit: lane i is 0xFF where the unit holds "value".
+    // The padding lanes hold 0 and value is 1..9, so they never match;
+    // the mask keeps only the 9 real lanes anyway.
+    const __m128i needle = _mm_set1_epi8((char)value);
+    const __m128i in_row = _mm_cmpeq_epi8(_mm_load_si128((const __m128i*)board->rows[row]), needle);
+    const __m128i in_col = _mm_cmpeq_epi8(_mm_load_si128((const __m128i*)board->cols[col]), needle);
+    const __m128i in_box = _mm_cmpeq_epi8(_mm_load_si128((const __m128i*)board->boxes[box]), needle);
+
+    const int hits = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(in_row, in_col), in_box));
+    return (hits & 0x1FF) == 0;
+#else
+    // No SSE2 (not x86): the same three contiguous units, byte by byte
+    for (int v = 0; v < 9; v++) {
+        if (board->rows[row][v] == value || board->cols[col][v] == value || board->boxes[box][v] == value) {
+            return 0;
+        }
+    }
+    return 1;
+#endif
+}
+
+static void set_cell(struct Board_Sse* board, int row, int col, uint8_t value)
+{
+    board->rows[row][col] = value;
+    board->cols[col][row] = value;
+    board->boxes[g_cell_box[row * 9 + col]][g_box_pos[row * 9 + col]] = value;
+}
+
+// Same search as v3: cells from left to right and top to bottom
+static int solve_recursive_sse(struct Board_Sse* board, int row, int col) {
+
+    if (row == 9) {
+        return 1;
+    }
+    else if (col == 9) {
+        return solve_recursive_sse(board, row + 1, 0);
+    }
+    if (board->rows[row][col] != 0) {
+        return solve_recursive_sse(board, row, col + 1);
+    }
+
+    for (uint8_t p = 1; p <= 9; p++) {
+
+        if (!is_valid_sse(board, row, col, p)) {
+            continue;
+        }
+
+        set_cell(board, row, col, p);
+
+        if (solve_recursive_sse(board, row, col + 1)) {
+            return 1;
+        }
+
+        set_cell(board, row, col, 0);
+    }
+    return 0;
+}
+
+void board_to_sse(const uint8_t cells[81], struct Board_Sse* out) {
+
+    memset(out, 0, sizeof(*out));
+
+    for (int row = 0; row < 9; row++) {
+        for (int col = 0; col < 9; col++) {
+            set_cell(out, row, col, cells[row * 9 + col]);
+        }
+    }
+}
+
+int solve_optimized_v3_sse( struct Board_CacheOptimized* input, struct Board_CacheOptimized* solution) {
+
+    struct Board_Sse board;
+    board_to_sse(input->cells_row_major, &board);
+
+    int found = solve_recursive_sse(&board, 0, 0);
+
+    // Back to the two layouts of v3 (unsolved boards come back unchanged)
+    uint8_t cells[81];
+    for (int row = 0; row < 9; row++) {
+        memcpy(&cells[row * 9], board.rows[row], 9);
+    }
+    board_to_cache_optimized(cells, solution);
+
+    return found;
+}
+
+// Exported for the microbenchmarks (sudoku_internal.h)
+int sudoku_is_valid_v3_sse(const struct Board_Sse* board, int row, int col, uint8_t value) {
+    return is_valid_sse(board, row, col, value);
+}
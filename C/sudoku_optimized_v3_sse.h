@@ -0,0 +1,35 @@
+#ifndef SUDOKU_OPTIMIZED_V3_SSE_H
+#define SUDOKU_OPTIMIZED_V3_SSE_H
+
+#include <stdint.h>
+
+#include "sudoku_optimized_v3.h"
+
+/*
+ * The v3 idea taken one step further: besides the row-major and the
+ * column-major copy, the board is also stored box by box, so each of the
+ * three units of a cell is 9 contiguous bytes. Every unit is padded to
+ * 16 bytes (one SSE register), so is_valid is three loads and compares.
+ */
+struct Board_Sse {
+    _Alignas(16) uint8_t rows[9][16];  // rows[r][c]
+    _Alignas(16) uint8_t cols[9][16];  // cols[c][r]
+    _Alignas(16) uint8_t boxes[9][16]; // boxes[box][(r % 3) * 3 + c % 3]
+};
+
+/*
+ * Fills the three layouts of "out" from a row-major board.
+ * The padding bytes are set to 0.
+ */
+void board_to_sse(const uint8_t cells[81], struct Board_Sse* out);
+
+/*
+ * Solves the Sudoku puzzle. Same input and output as solve_optimized_v3 (so
+ * both are benchmarked the same way); the search runs on a struct Board_Sse.
+ * "input" is the unsolved puzzle (it is not modified).
+ * "solution" is the solved Sudoku puzzle
+ * Returns 1 if a solution is found, 0 if no solution exists.
+ */
+int solve_optimized_v3_sse( struct Board_CacheOptimized* input, struct Board_CacheOptimized* solution);
+
+#endif // SUDOKU_OPTIMIZED_V3_SSE_H
@@ -1,6 +1,8 @@
 #include "sudoku_optimized_v4.h"
+#include "sudoku_internal.h"
 
-static int is_valid_unoptimized_UNROLLED(const struct Board* board, int row, int col, uint8_t value) {
+// always_inline: the exported copy below must not change how the solver is compiled
+static inline __attribute__((always_inline)) int is_valid_unoptimized_UNROLLED(const struct Board* board, int row, int col, uint8_t value) {
     
     const uint8_t* cells = board->cells;
     int i = row * 9;
@@ -82,4 +84,9 @@ int solve_optimized_v4( struct Board* input, struct Board* solution) {
     memcpy(solution, input, sizeof(struct Board));
 
     return solve_recursive_unoptimized_UNROLLED(solution, 0, 0);
-}
\ No newline at end of file
+}
+
+// Exported for the microbenchmarks (sudoku_internal.h)
+int sudoku_is_valid_v4(const struct Board* board, int row, int col, uint8_t value) {
+    return is_valid_unoptimized_UNROLLED(board, row, col, value);
+}
@@ -1,4 +1,6 @@
 #include "sudoku_optimized_v5.h"
+#include "sudoku_internal.h"
+#include "sudoku_tables.h"
 
 // This table maps a row (0-8) to the starding row of its grid
 static const uint8_t g_box_start_lookup[9] = {
@@ -39,34 +41,41 @@ static int is_valid_unoptimized_LOOKUP(const struct Board* board, int row, int c
     return 1;
 }
 
-static int solve_recursive_unoptimized_LOOKUP(struct Board* board, int row, int col) {
-    if (row == 9) {
+// Only the cells that were empty at the start are visited (sudoku_tables.h),
+// and their row and column are two more table reads
+static int solve_recursive_unoptimized_LOOKUP(struct Board* board, const uint8_t* empty, int remaining) {
+    if (remaining == 0) {
         return 1;
-    } 
-    else if (col == 9) {
-        return solve_recursive_unoptimized_LOOKUP(board, row + 1, 0);
-    } 
-    else if (board->cells[row * 9 + col] != 0) {
-        return solve_recursive_unoptimized_LOOKUP(board, row, col + 1);
-    } 
-    else {
-        for (uint8_t p = 1; p <= 9; p++) {
-            if (!is_valid_unoptimized_LOOKUP(board, row, col, p)) {
-                continue;
-            }
-            board->cells[row * 9 + col] = p;
-            if (solve_recursive_unoptimized_LOOKUP(board, row, col + 1)) {
-                return 1;
-            }
-            board->cells[row * 9 + col] = 0;
+    }
+
+    const int cell = empty[0];
+    const int row = g_cell_row[cell];
+    const int col = g_cell_col[cell];
+
+    for (uint8_t p = 1; p <= 9; p++) {
+        if (!is_valid_unoptimized_LOOKUP(board, row, col, p)) {
+            continue;
         }
-        return 0;
+        board->cells[cell] = p;
+        if (solve_recursive_unoptimized_LOOKUP(board, empty + 1, remaining - 1)) {
+            return 1;
+        }
+        board->cells[cell] = 0;
     }
+    return 0;
 }
 
 int solve_optimized_v5( struct Board* input, struct Board* solution) {
 
     memcpy(solution, input, sizeof(struct Board));
 
-    return solve_recursive_unoptimized_LOOKUP(solution, 0, 0);
-}
\ No newline at end of file
+    uint8_t empty[81];
+    int empty_count = collect_empty_cells(solution, empty);
+
+    return solve_recursive_unoptimized_LOOKUP(solution, empty, empty_count);
+}
+
+// Exported for the microbenchmarks (sudoku_internal.h)
+int sudoku_is_valid_v5(const struct Board* board, int row, int col, uint8_t value) {
+    return is_valid_unoptimized_LOOKUP(board, row, col, value);
+}
@@ -0,0 +1,128 @@
+#include "sudoku_optimized_v6.h"
+#include "sudoku.h"
+#include "sudoku_tables.h"
+
+#define ALL_VALUES 0x1FF // bits 0..8 = numbers 1..9
+
+struct SearchState {
+    uint8_t* cells;
+    uint16_t rows[9];
+    uint16_t cols[9];
+    uint16_t boxes[9];
+
+    // Indices of the empty cells. empty[depth .. empty_count) are still empty,
+    // the ones before "depth" are filled by the current branch.
+    uint8_t empty[81];
+    int empty_count;
+};
+
+// The numbers that can still go into cell i
+static inline uint16_t candidates(const struct SearchState* s, int i) {
+    return ~(s->rows[g_cell_row[i]] | s->cols[g_cell_col[i]] | s->boxes[g_cell_box[i]]) & ALL_VALUES;
+}
+
+/*
+ * Forward checking: after a number was placed in "cell", every empty peer
+ * (same row, column or box, sudoku_tables.h) must still have at least one
+ * candidate. Only the peers lost a candidate, so the rest of the board is not checked.
+ * Returns 1 if the placement leaves every peer with a candidate, 0 otherwise.
+ */
+static int peers_have_candidates(const struct SearchState* s, int cell) {
+    const uint8_t* peers = g_cell_peers[cell];
+
+    for (int k = 0; k < SUDOKU_PEERS; k++) {
+        int i = peers[k];
+        if (s->cells[i] == 0 && candidates(s, i) == 0)
+            return 0;
+    }
+
+    return 1;
+}
+
+static int solve_recursive_mrv(struct SearchState* s, int depth) {
+    // Every empty cell is filled: the puzzle is solved
+    if (depth == s->empty_count) {
+        return 1;
+    }
+
+    // MRV: pick the empty cell with the fewest candidates.
+    // A cell with one candidate cannot be beaten, so the scan stops there.
+    int best = depth;
+    int best_count = 10;
+    for (int k = depth; k < s->empty_count; k++) {
+        int count = __builtin_popcount(candidates(s, s->empty[k]));
+        if (count < best_count) {
+            best = k;
+            best_count = count;
+            if (count <= 1)
+                break;
+        }
+    }
+
+    if (best_count == 0) {
+        return 0; // dead end, some cell has no number left
+    }
+
+    // Move the chosen cell to position "depth", the remaining ones follow it
+    uint8_t cell = s->empty[best];
+    s->empty[best] = s->empty[depth];
+    s->empty[depth] = cell;
+
+    const int row = g_cell_row[cell];
+    const int col = g_cell_col[cell];
+    const int box = g_cell_box[cell];
+
+    uint16_t avail = candidates(s, cell);
+    while (avail) {
+        const uint16_t mask = avail & -avail; // lowest candidate first, like v2
+        avail &= avail - 1;
+
+        s->cells[cell] = (uint8_t)(__builtin_ctz(mask) + 1);
+        s->rows[row] |= mask;
+        s->cols[col] |= mask;
+        s->boxes[box] |= mask;
+
+        if (peers_have_candidates(s, cell) && solve_recursive_mrv(s, depth + 1)) {
+            return 1; // Solution found
+        }
+
+        s->cells[cell] = 0;
+        s->rows[row] &= ~mask;
+        s->cols[col] &= ~mask;
+        s->boxes[box] &= ~mask;
+    }
+
+    return 0;
+}
+
+
+int solve_optimized_v6(struct Board* input, struct Board* solution) {
+    struct SearchState s;
+    memset(&s, 0, sizeof(s));
+
+    memcpy(solution, input, sizeof(struct Board));
+    s.cells = solution->cells;
+
+    // Same setup as v2: set the bits of the given numbers, reject duplicates
+    for (int i = 0; i < 81; i++) {
+        uint8_t p = s.cells[i];
+
+        if (p == 0) {
+            continue;
+        }
+
+        const uint16_t mask = 1 << (p - 1);
+        if ((s.rows[g_cell_row[i]] & mask) || (s.cols[g_cell_col[i]] & mask) || (s.boxes[g_cell_box[i]] & mask)) {
+            // Invalid input table. Contains duplicates
+            return 0;
+        }
+
+        s.rows[g_cell_row[i]] |= mask;
+        s.cols[g_cell_col[i]] |= mask;
+        s.boxes[g_cell_box[i]] |= mask;
+    }
+
+    s.empty_count = collect_empty_cells(solution, s.empty);
+
+    return solve_recursive_mrv(&s, 0);
+}
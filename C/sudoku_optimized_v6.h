@@ -0,0 +1,15 @@
+#ifndef SUDOKU_OPTIMIZED_V6_H
+#define SUDOKU_OPTIMIZED_V6_H
+
+#include "sudoku.h"
+/*
+ * Solves the Sudoku puzzle. The optimized function (v6) of the "solve" function:
+ * bitmasks like v2, but the next cell is the one with the fewest candidates (MRV)
+ * and every placement is checked against its peers first (forward checking).
+ * "input" is the unsolved puzzle (it is not modified).
+ * "solution" is the solved Sudoku puzzle
+ * Returns 1 if a solution is found, 0 if no solution exists.
+ */
+int solve_optimized_v6( struct Board* input, struct Board* solution);
+
+#endif // SUDOKU_OPTIMIZED_V6_H
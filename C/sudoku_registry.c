@@ -0,0 +1,50 @@
+#include "sudoku_registry.h"
+#include "sudoku_unoptimized.h"
+#include "sudoku_optimized_v0.h"
+#include "sudoku_optimized_v1.h"
+#include "sudoku_optimized_v2.h"
+#include "sudoku_optimized_v4.h"
+#include "sudoku_optimized_v5.h"
+#include "sudoku_optimized_v6.h"
+#include "sudoku_optimized_v3_sse.h"
+
+#define ROW_MAJOR(solver)       .board_kind = BOARD_ROW_MAJOR, .fn.row_major = solver
+#define CACHE_OPTIMIZED(solver) .board_kind = BOARD_CACHE_OPTIMIZED, .fn.cache_optimized = solver
+
+const struct SolverEntry SOLVERS[] = {
+    {.index = 6, .name = "solve_unoptimized",  .title = "unoptimized version",    ROW_MAJOR(solve_unoptimized)},
+    {.index = 0, .name = "solve_optimized_v0", .title = "addition of a variable", ROW_MAJOR(solve_optimized_v0)},
+    {.index = 1, .name = "solve_optimized_v1", .title = "combined loops",         ROW_MAJOR(solve_optimized_v1)},
+    {.index = 2, .name = "solve_optimized_v2", .title = "Bitmask",                ROW_MAJOR(solve_optimized_v2)},
+    {.index = 3, .name = "solve_optimized_v3", .title = "cache optimization",     CACHE_OPTIMIZED(solve_optimized_v3)},
+    {.index = 4, .name = "solve_optimized_v4", .title = "Loop unrolling",         ROW_MAJOR(solve_optimized_v4)},
+    {.index = 5, .name = "solve_optimized_v5", .title = "Lookup table",           ROW_MAJOR(solve_optimized_v5)},
+    {.index = 7, .name = "solve_optimized_v6", .title = "MRV + forward checking", ROW_MAJOR(solve_optimized_v6)},
+    {.index = 8, .name = "solve_optimized_v3_sse", .title = "SSE compare on 3 layouts", CACHE_OPTIMIZED(solve_optimized_v3_sse)},
+};
+
+const int SOLVER_COUNT = (int)(sizeof(SOLVERS) / sizeof(SOLVERS[0]));
+
+const struct SolverEntry* find_solver(int index) {
+    for (int i = 0; i < SOLVER_COUNT; i++) {
+        if (SOLVERS[i].index == index) {
+            return &SOLVERS[i];
+        }
+    }
+    return NULL;
+}
+
+int solve_entry(const struct SolverEntry* entry, struct Board* input, struct Board* solution) {
+    if (entry->board_kind == BOARD_ROW_MAJOR) {
+        return entry->fn.row_major(input, solution);
+    }
+
+    struct Board_CacheOptimized input_cache;
+    Solution_CacheOptimized output_cache;
+    board_to_cache_optimized(input->cells, &input_cache);
+    int found = entry->fn.cache_optimized(&input_cache, &output_cache);
+    if (found) {
+        memcpy(solution->cells, output_cache.cells_row_major, 81);
+    }
+    return found;
+}
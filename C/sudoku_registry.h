@@ -0,0 +1,49 @@
+#ifndef SUDOKU_REGISTRY_H
+#define SUDOKU_REGISTRY_H
+
+#include "sudoku.h"
+#include "sudoku_optimized_v3.h"
+
+/*
+ * The list of all solver variants, used by sudoku_solver (main.c), sudoku_test
+ * (test.c) and the benchmarks. A new variant only needs a line in
+ * sudoku_registry.c to be solved, tested and benchmarked by all of them.
+ */
+
+// The board layout a solver works on
+enum BoardKind {
+    BOARD_ROW_MAJOR,       // struct Board
+    BOARD_CACHE_OPTIMIZED, // struct Board_CacheOptimized (v3, v3_sse)
+};
+
+struct SolverEntry {
+    int index;             // "optimization index" of sudoku_solver and opt_index of the csv files
+    const char* name;      // function name, e.g. "solve_optimized_v2"
+    const char* title;     // what the variant changes, for the usage text and the reports
+    enum BoardKind board_kind;
+    union {
+        SolverFunc row_major;                     // board_kind == BOARD_ROW_MAJOR
+        SolverFuncCacheOptimized cache_optimized; // board_kind == BOARD_CACHE_OPTIMIZED
+    } fn;
+};
+
+// Unknown indexes run this solver (the unoptimized one), as main.c always did
+#define SOLVER_INDEX_DEFAULT 6
+
+// In report order: the unoptimized baseline first, then by index
+extern const struct SolverEntry SOLVERS[];
+extern const int SOLVER_COUNT;
+
+/*
+ * Returns the entry with this index, NULL if there is none.
+ */
+const struct SolverEntry* find_solver(int index);
+
+/*
+ * Solves a row-major board with any entry: cache-optimized solvers get the
+ * board converted and their solution converted back.
+ * Returns 1 if a solution is found, 0 if no solution exists.
+ */
+int solve_entry(const struct SolverEntry* entry, struct Board* input, struct Board* solution);
+
+#endif // SUDOKU_REGISTRY_H
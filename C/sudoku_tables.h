@@ -0,0 +1,30 @@
+#ifndef SUDOKU_TABLES_H
+#define SUDOKU_TABLES_H
+
+#include <stdint.h>
+
+#include "sudoku.h"
+
+/*
+ * Precomputed cell tables shared by the solvers that opt into them (v2, v5,
+ * v6, v3_sse). Cell i is row i / 9, column i % 9: the tables replace these
+ * divisions and the (row / 3) * 3 + (col / 3) of the box in the search.
+ */
+
+#define SUDOKU_PEERS 20 // cells that share a row, a column or a box with a cell
+
+extern const uint8_t g_cell_row[81];
+extern const uint8_t g_cell_col[81];
+extern const uint8_t g_cell_box[81];
+
+// g_cell_peers[i]: the 20 other cells of the row, column and box of cell i
+extern const uint8_t g_cell_peers[81][SUDOKU_PEERS];
+
+/*
+ * Writes the indices of the empty cells of "board" into "empty", in row-major
+ * order, so a search can go over the unknown cells only.
+ * Returns the number of empty cells.
+ */
+int collect_empty_cells(const struct Board* board, uint8_t empty[81]);
+
+#endif // SUDOKU_TABLES_H
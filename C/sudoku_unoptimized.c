@@ -1,4 +1,5 @@
 #include "sudoku.h"
+#include "sudoku_internal.h"
 
 static int is_valid_unoptimized(const struct Board* board, int row, int col, uint8_t value) {
     // is unique in row
@@ -68,4 +69,9 @@ int solve_unoptimized( struct Board* input, struct Board* solution) {
     memcpy(solution, input, sizeof(struct Board));
 
     return solve_recursive_unoptimized(solution, 0, 0);
-}
\ No newline at end of file
+}
+
+// Exported for the microbenchmarks (sudoku_internal.h)
+int sudoku_is_valid_unoptimized(const struct Board* board, int row, int col, uint8_t value) {
+    return is_valid_unoptimized(board, row, col, value);
+}
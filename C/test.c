@@ -3,13 +3,9 @@
 #include <stdbool.h>
 
 #include "sudoku.h"
-#include "sudoku_unoptimized.h"
-#include "sudoku_optimized_v0.h"
-#include "sudoku_optimized_v1.h"
-#include "sudoku_optimized_v2.h"
 #include "sudoku_optimized_v3.h"
-#include "sudoku_optimized_v4.h"
-#include "sudoku_optimized_v5.h"
+#include "sudoku_registry.h"
+#include "sudoku_tables.h"
 
 typedef int (*solve_function)(struct Board *, struct Board *);
 typedef int (*solve_function_cache_optimized)(struct Board_CacheOptimized *, struct Board_CacheOptimized *);
@@ -177,14 +173,57 @@ bool run_tests_cache_optimized(const char *group_name, solve_function_cache_opti
     return all_tests_pass;
 }
 
+// Checks the precomputed tables of sudoku_tables.c against their definition
+bool run_table_tests(void) {
+    bool pass = true;
+    puts("-----> sudoku_tables\n");
+
+    for (int i = 0; i < 81 && pass; i++) {
+        int row = i / 9;
+        int col = i % 9;
+        int box = (row / 3) * 3 + col / 3;
+        pass = g_cell_row[i] == row && g_cell_col[i] == col && g_cell_box[i] == box;
+
+        // the peers: 20 different cells, each sharing a unit with cell i
+        bool seen[81] = {false};
+        for (int k = 0; k < SUDOKU_PEERS && pass; k++) {
+            int p = g_cell_peers[i][k];
+            bool shares_unit = g_cell_row[p] == row || g_cell_col[p] == col || g_cell_box[p] == box;
+            pass = p != i && !seen[p] && shares_unit;
+            seen[p] = true;
+        }
+    }
+
+    struct Board board = {0};
+    uint8_t empty[81];
+    pass = pass && read_file(&board, "../boards/solvable-easy-1.sudoku") == 0;
+    int count = collect_empty_cells(&board, empty);
+    int expected = 0;
+    for (int i = 0; i < 81; i++)
+        expected += board.cells[i] == 0;
+    pass = pass && count == expected;
+    for (int k = 0; k < count && pass; k++)
+        pass = board.cells[empty[k]] == 0 && (k == 0 || empty[k] > empty[k - 1]);
+
+    printf("Cell tables and empty cells: %s\n\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
 int main(void) {
     bool all_tests_pass = true;
-    all_tests_pass &= run_tests("------> solve_unoptimized()", solve_unoptimized);
-    all_tests_pass &= run_tests("------> solve_optimized_v0()", solve_optimized_v0);
-    all_tests_pass &= run_tests("------> solve_optimized_v1()", solve_optimized_v1);
-    all_tests_pass &= run_tests("------> solve_optimized_v2()", solve_optimized_v2);
-    all_tests_pass &= run_tests_cache_optimized("------> solve_optimized_v3()", solve_optimized_v3);
-    all_tests_pass &= run_tests("------> solve_optimized_v4()", solve_optimized_v4);
-    all_tests_pass &= run_tests("------> solve_optimized_v5()", solve_optimized_v5);
+
+    all_tests_pass &= run_table_tests();
+
+    // Every solver of the registry, each on its own board layout
+    for (int i = 0; i < SOLVER_COUNT; i++) {
+        const struct SolverEntry* entry = &SOLVERS[i];
+        char group_name[64];
+        snprintf(group_name, sizeof(group_name), "------> %s()", entry->name);
+
+        if (entry->board_kind == BOARD_CACHE_OPTIMIZED)
+            all_tests_pass &= run_tests_cache_optimized(group_name, entry->fn.cache_optimized);
+        else
+            all_tests_pass &= run_tests(group_name, entry->fn.row_major);
+    }
     return all_tests_pass ? 0 : 1;
-}
\ No newline at end of file
+}
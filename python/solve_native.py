@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""
+Solves a file of boards (81-character lines or blocks of 9 rows like
+dataset/ex.txt; 0 or . = empty cell)
+with the native engines of ../C++ (module sudoku_native, built with
+"make python_module" in ../C++).
+
+    python3 solve_native.py boards.txt [--engine dlx] [--threads N] [--out FILE]
+"""
+import argparse
+import sys
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "C++"))
+
+import numpy as np
+import sudoku_native
+
+
+def load_boards(path):
+    # every cell of the file in order, 81 per board
+    text = Path(path).read_text().replace(".", "0")
+    cells = "".join(c for c in text if c.isdigit())
+    count = len(cells) // 81
+    # (N, 81) uint8, one board per row
+    data = np.frombuffer(cells[:count * 81].encode(), dtype=np.uint8) - ord("0")
+    return data.reshape(count, 81)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("boards")
+    parser.add_argument("--engine", default="dlx", choices=sudoku_native.engines())
+    parser.add_argument("--threads", type=int, default=0, help="0 = one per CPU")
+    parser.add_argument("--out", help="write the solutions here, one per line")
+    args = parser.parse_args()
+
+    puzzles = load_boards(args.boards)
+
+    start = time.perf_counter()
+    solutions, status = sudoku_native.solve_batch(puzzles, engine=args.engine,
+                                                  threads=args.threads)
+    elapsed = time.perf_counter() - start
+
+    solved = int((status == sudoku_native.SOLVED).sum())
+    invalid = int((status == sudoku_native.INVALID).sum())
+    print(f"{len(puzzles)} boards, {solved} solved, {invalid} invalid")
+    if len(puzzles):
+        print(f"{elapsed * 1e3:.1f} ms, {len(puzzles) / elapsed:.0f} boards/s ({args.engine})")
+
+    if args.out:
+        with open(args.out, "w") as f:
+            for row in solutions:
+                f.write("".join(map(str, row)) + "\n")
+
+
+if __name__ == "__main__":
+    main()